@@ -0,0 +1,10 @@
+/* Référence C de affichage.p */
+#include <stdio.h>
+
+unsigned long long i;
+
+int main(void) {
+    for (i = 1; i <= 2000000; i++)
+        printf("%llu\n", i * 3);
+    return 0;
+}
@@ -0,0 +1,7 @@
+(* Boucle d'affichage : 2.10^6 DISPLAY *)
+VAR
+    i : INTEGER.
+BEGIN
+    FOR i := 1 TO 2000000 DO
+        DISPLAY i * 3
+END.
@@ -0,0 +1,29 @@
+(* Petites fonctions appelées dans une boucle : candidates à l'expansion en ligne,
+   plus une récursion terminale éliminée *)
+VAR
+    i, n, s : INTEGER.
+FUNCTION carre(x : INTEGER) : INTEGER;
+BEGIN
+    carre := x * x
+END;
+FUNCTION moyenne(a, b : INTEGER) : INTEGER;
+BEGIN
+    moyenne := (a + b) / 2
+END;
+FUNCTION somme(k, acc : INTEGER) : INTEGER;
+BEGIN
+    IF k == 0 THEN
+        somme := acc
+    ELSE
+        somme := somme(k - 1, acc + k)
+END;
+BEGIN
+    n := 20000000;
+    WHILE i < n DO
+    BEGIN
+        s := s + moyenne(carre(i % 1000), i);
+        i := i + 1
+    END;
+    DISPLAY s;
+    DISPLAY somme(10000000, 0)
+END.
@@ -0,0 +1,42 @@
+#!/bin/sh
+# Débit du compilateur sur des programmes générés par bench/gen_prog.
+# Pour chaque taille, affiche les mesures de "compilateur --stats" (lexèmes/s,
+# lignes/s, temps de chaque phase, mémoire maximale) et les ajoute à un
+# fichier CSV, une ligne par mesure, pour comparer les commits entre eux.
+# Usage : bench/bench_compile.sh
+# Variables : TAILLES (lignes, "1000 10000 100000"), GRAINE (1),
+#             RESULTATS (bench/resultats_compile.csv)
+
+TAILLES=${TAILLES:-"1000 10000 100000"}
+GRAINE=${GRAINE:-1}
+RESULTATS=${RESULTATS:-bench/resultats_compile.csv}
+CLES="lignes lexemes lecture_ms lexical_ms analyse_ms passes_ms emission_ms total_ms lexemes_par_s lignes_par_s rss_max_ko"
+
+commit=$(git rev-parse --short HEAD 2>/dev/null || echo inconnu)
+if [ -n "$(git status --porcelain --untracked-files=no 2>/dev/null)" ]; then
+    commit="$commit-modifie"
+fi
+date=$(date -u +%Y-%m-%dT%H:%M:%SZ)
+
+if [ ! -f "$RESULTATS" ]; then
+    echo "commit,date,graine,taille,$(echo $CLES | tr ' ' ',')" > "$RESULTATS"
+fi
+
+for taille in $TAILLES; do
+    programme=bench/prog_$taille.p
+    ./bench/gen_prog "$GRAINE" "$taille" > "$programme" || exit 1
+    if ! ./compilateur --stats < "$programme" > /dev/null 2> bench/stats.txt; then
+        echo "Échec de la compilation de $programme" >&2
+        cat bench/stats.txt >&2
+        exit 1
+    fi
+    echo "== $programme"
+    sed -n 's/^stats //p' bench/stats.txt
+    ligne="$commit,$date,$GRAINE,$taille"
+    for cle in $CLES; do
+        ligne="$ligne,$(sed -n "s/^stats $cle //p" bench/stats.txt)"
+    done
+    echo "$ligne" >> "$RESULTATS"
+done
+rm -f bench/stats.txt
+echo "Résultats ajoutés à $RESULTATS"
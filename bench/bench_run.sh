@@ -0,0 +1,95 @@
+#!/bin/sh
+# Vitesse du code généré : chaque noyau bench/<noyau>.p compilé par
+# compilateur est comparé au même programme en C (bench/<noyau>.c) compilé
+# par gcc -O0 et gcc -O2. Avec perf, mesure les cycles et les instructions ;
+# sans perf, seulement le temps écoulé. Le rapport au C porte sur les cycles
+# (ou sur le temps sans perf). Les sorties des trois versions doivent être
+# identiques. Les mesures sont ajoutées à un fichier CSV pour comparer les commits.
+# Usage : bench/bench_run.sh (les exécutables sont construits par make bench-run)
+# Variables : NOYAUX, REPETITIONS (3, on garde la meilleure),
+#             RESULTATS (bench/resultats_run.csv)
+
+NOYAUX=${NOYAUX:-"compte modulo doubles affichage"}
+REPETITIONS=${REPETITIONS:-3}
+RESULTATS=${RESULTATS:-bench/resultats_run.csv}
+
+if command -v perf >/dev/null 2>&1 && perf stat -e cycles true >/dev/null 2>&1; then
+    PERF=1
+else
+    PERF=0
+    echo "perf indisponible : temps écoulé seulement"
+fi
+
+commit=$(git rev-parse --short HEAD 2>/dev/null || echo inconnu)
+if [ -n "$(git status --porcelain --untracked-files=no 2>/dev/null)" ]; then
+    commit="$commit-modifie"
+fi
+date=$(date -u +%Y-%m-%dT%H:%M:%SZ)
+
+if [ ! -f "$RESULTATS" ]; then
+    echo "commit,date,noyau,version,cycles,instructions,temps_ms,rapport_O0,rapport_O2" > "$RESULTATS"
+fi
+
+# Mesure un exécutable : meilleure des REPETITIONS exécutions ;
+# écrit "cycles instructions temps_ms" (cycles et instructions à "-" sans perf)
+Mesure() {
+    meilleur=""
+    r=0
+    while [ $r -lt "$REPETITIONS" ]; do
+        debut=$(date +%s%N)
+        if [ $PERF = 1 ]; then
+            perf stat -x, -e cycles,instructions -o bench/perf.txt "$1" > bench/sortie.txt
+        else
+            "$1" > bench/sortie.txt
+        fi
+        fin=$(date +%s%N)
+        temps=$(( (fin - debut) / 1000 ))
+        if [ $PERF = 1 ]; then
+            cycles=$(awk -F, '$3 ~ /^cycles/ {print $1}' bench/perf.txt)
+            instructions=$(awk -F, '$3 ~ /^instructions/ {print $1}' bench/perf.txt)
+        else
+            cycles=-
+            instructions=-
+        fi
+        cle=$cycles
+        [ $PERF = 0 ] && cle=$temps
+        if [ -z "$meilleur" ] || [ "$cle" -lt "$meilleur" ]; then
+            meilleur=$cle
+            mesure="$cycles $instructions $(awk "BEGIN {printf \"%.1f\", $temps / 1000}")"
+        fi
+        r=$((r + 1))
+    done
+    echo "$mesure"
+}
+
+printf "%-10s %-8s %14s %14s %6s %10s %8s %8s\n" noyau version cycles instructions IPC temps_ms "/C-O0" "/C-O2"
+for noyau in $NOYAUX; do
+    for version in O0 O2 p; do
+        case $version in
+            p) executable=bench/$noyau ;;
+            *) executable=bench/$noyau-$version ;;
+        esac
+        set -- $(Mesure "$executable")
+        cp bench/sortie.txt bench/sortie_$version.txt
+        eval "cycles_$version=$1 instructions_$version=$2 temps_$version=$3"
+    done
+    if ! cmp -s bench/sortie_p.txt bench/sortie_O2.txt || ! cmp -s bench/sortie_p.txt bench/sortie_O0.txt; then
+        echo "Attention : $noyau ne produit pas la même sortie que sa référence C" >&2
+    fi
+
+    for version in O0 O2 p; do
+        eval "cycles=\$cycles_$version instructions=\$instructions_$version temps=\$temps_$version"
+        if [ $PERF = 1 ]; then
+            rapports=$(awk "BEGIN {printf \"%.2f %.2f %.2f\", $instructions / $cycles, $cycles / $cycles_O0, $cycles / $cycles_O2}")
+        else
+            rapports=$(awk "BEGIN {printf \"- %.2f %.2f\", $temps / $temps_O0, $temps / $temps_O2}")
+        fi
+        set -- $rapports
+        nom=C-$version
+        [ $version = p ] && nom=MonComp
+        printf "%-10s %-8s %14s %14s %6s %10s %8s %8s\n" "$noyau" "$nom" "$cycles" "$instructions" "$1" "$temps" "$2" "$3"
+        echo "$commit,$date,$noyau,$nom,$cycles,$instructions,$temps,$2,$3" | sed 's/,-,/,,/g; s/,-,/,,/g' >> "$RESULTATS"
+    done
+done
+rm -f bench/perf.txt bench/sortie.txt bench/sortie_*.txt
+echo "Résultats ajoutés à $RESULTATS"
@@ -0,0 +1,24 @@
+/* Référence C de branches.p */
+#include <stdio.h>
+
+unsigned long long i, x, y, m, s;
+
+int main(void) {
+    x = 1;
+    y = 2;
+    for (i = 1; i <= 50000000; i++) {
+        x = x * 1103515245 + 12345;
+        y = y * 69069 + 1;
+        if (x < y)
+            m = x;
+        else
+            m = y;
+        if (m > x - y)
+            s = s + 3;
+        else
+            s = s + 1;
+        s = s + m;
+    }
+    printf("%llu\n", s);
+    return 0;
+}
@@ -0,0 +1,23 @@
+(* Branchements imprévisibles : deux suites pseudo-aléatoires (générateurs
+   congruentiels) comparées à chaque tour, vrai une fois sur deux au hasard *)
+VAR
+    i, x, y, m, s : INTEGER.
+BEGIN
+    x := 1;
+    y := 2;
+    FOR i := 1 TO 50000000 DO
+    BEGIN
+        x := x * 1103515245 + 12345;
+        y := y * 69069 + 1;
+        IF x < y THEN
+            m := x
+        ELSE
+            m := y;
+        IF m > x - y THEN
+            s := s + 3
+        ELSE
+            s := s + 1;
+        s := s + m
+    END;
+    DISPLAY s
+END.
@@ -0,0 +1,23 @@
+(* Automate à 10 états : aiguillage par CASE (table de sauts) *)
+VAR
+    etat, i, n, s : INTEGER.
+BEGIN
+    n := 50000000;
+    WHILE i < n DO
+    BEGIN
+        CASE etat OF
+            0: BEGIN s := s + 1; etat := 7 END;
+            1: BEGIN s := s + 2; etat := 4 END;
+            2: BEGIN s := s + 3; etat := 9 END;
+            3: BEGIN s := s + 4; etat := 0 END;
+            4: BEGIN s := s + 5; etat := 8 END;
+            5: BEGIN s := s + 6; etat := 2 END;
+            6: BEGIN s := s + 7; etat := 5 END;
+            7: BEGIN s := s + 8; etat := 3 END;
+            8: BEGIN s := s + 9; etat := 6 END;
+            9: BEGIN s := s + 10; etat := 1 END
+        END;
+        i := i + 1
+    END;
+    DISPLAY s
+END.
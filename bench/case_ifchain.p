@@ -0,0 +1,21 @@
+(* Même automate que case_dispatch.p, écrit avec une chaîne de IF *)
+VAR
+    etat, i, n, s : INTEGER.
+BEGIN
+    n := 50000000;
+    WHILE i < n DO
+    BEGIN
+        IF etat == 0 THEN BEGIN s := s + 1; etat := 7 END
+        ELSE IF etat == 1 THEN BEGIN s := s + 2; etat := 4 END
+        ELSE IF etat == 2 THEN BEGIN s := s + 3; etat := 9 END
+        ELSE IF etat == 3 THEN BEGIN s := s + 4; etat := 0 END
+        ELSE IF etat == 4 THEN BEGIN s := s + 5; etat := 8 END
+        ELSE IF etat == 5 THEN BEGIN s := s + 6; etat := 2 END
+        ELSE IF etat == 6 THEN BEGIN s := s + 7; etat := 5 END
+        ELSE IF etat == 7 THEN BEGIN s := s + 8; etat := 3 END
+        ELSE IF etat == 8 THEN BEGIN s := s + 9; etat := 6 END
+        ELSE BEGIN s := s + 10; etat := 1 END;
+        i := i + 1
+    END;
+    DISPLAY s
+END.
@@ -0,0 +1,11 @@
+/* Référence C de compte.p */
+#include <stdio.h>
+
+unsigned long long i, s;
+
+int main(void) {
+    for (i = 1; i <= 200000000; i++)
+        s = s * 3 + i;
+    printf("%llu\n", s);
+    return 0;
+}
@@ -0,0 +1,8 @@
+(* Boucle de comptage : 2.10^8 itérations dépendantes (pas de forme close pour gcc -O2) *)
+VAR
+    i, s : INTEGER.
+BEGIN
+    FOR i := 1 TO 200000000 DO
+        s := s * 3 + i;
+    DISPLAY s
+END.
@@ -0,0 +1,20 @@
+(* Noyau de mesure de la disposition des données :
+   avec --layout=declaration, s et i chevauchent une frontière de ligne de cache *)
+VAR
+    c : CHAR;
+    fa, fb, fc, fd, fe, ff, fg : INTEGER;
+    s : INTEGER;
+    ga, gb, gc, gd, ge, gf, gg, gh : INTEGER;
+    n : INTEGER;
+    ha, hb, hc, hd, he, hf : INTEGER;
+    i : INTEGER.
+BEGIN
+    c := 'x';
+    n := 100000000;
+    WHILE i < n DO
+    BEGIN
+        s := s + i;
+        i := i + 1
+    END;
+    DISPLAY s
+END.
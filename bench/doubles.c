@@ -0,0 +1,15 @@
+/* Référence C de doubles.p */
+#include <stdio.h>
+
+unsigned long long i;
+double x, s;
+
+int main(void) {
+    for (i = 1; i <= 20000000; i++) {
+        x = x + 0.5;
+        s = s + x * 0.001 - s / 1000.0;
+    }
+    printf("%f\n", x);
+    printf("%f\n", s);
+    return 0;
+}
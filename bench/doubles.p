@@ -0,0 +1,13 @@
+(* Arithmétique DOUBLE, comme tests/test_tp7.p *)
+VAR
+    i : INTEGER;
+    x, s : DOUBLE.
+BEGIN
+    FOR i := 1 TO 20000000 DO
+    BEGIN
+        x := x + 0.5;
+        s := s + x * 0.001 - s / 1000.0
+    END;
+    DISPLAY x;
+    DISPLAY s
+END.
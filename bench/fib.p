@@ -0,0 +1,14 @@
+(* Appels récursifs : fib(32) *)
+VAR
+    r : INTEGER.
+FUNCTION fib(n : INTEGER) : INTEGER;
+BEGIN
+    IF n < 2 THEN
+        fib := n
+    ELSE
+        fib := fib(n - 1) + fib(n - 2)
+END;
+BEGIN
+    r := fib(32);
+    DISPLAY r
+END.
@@ -0,0 +1,45 @@
+// Générateur d'expressions de stress pour l'analyseur d'expressions
+// Usage : gen_expr long <N>      une affectation de N termes : a := 1 + 2 * 3 - ...
+//         gen_expr profonde <N>  N parenthèses imbriquées : a := ((((1 + 1) + 1) ...)
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage : " << argv[0] << " long|profonde <N>" << endl;
+        return 1;
+    }
+    string forme = argv[1];
+    long n = atol(argv[2]);
+
+    cout << "VAR a : INTEGER." << endl;
+    cout << "BEGIN" << endl;
+    cout << "    a := ";
+    if (forme == "long") {
+        const char* operateurs[] = {" + ", " * ", " - ", " + "};
+        for (long i = 0; i < n; i++) {
+            if (i > 0) {
+                cout << operateurs[i % 4];
+                if (i % 20 == 0) cout << endl << "        ";
+            }
+            cout << 1 + i % 9;
+        }
+    }
+    else if (forme == "profonde") {
+        cout << string(n, '(') << 1;
+        for (long i = 0; i < n; i++)
+            cout << " + 1)";
+    }
+    else {
+        cerr << "Forme inconnue : " << forme << endl;
+        return 1;
+    }
+    cout << ";" << endl;
+    cout << "    DISPLAY a" << endl;
+    cout << "END." << endl;
+    return 0;
+}
@@ -0,0 +1,267 @@
+// Générateur de programmes pour le banc d'essai du compilateur (make bench-compile)
+// Usage : gen_prog <graine> <lignes>
+// Produit un programme valide d'environ <lignes> lignes : beaucoup de variables
+// déclarées par VAR, des blocs BEGIN/END imbriqués profondément, de longues
+// expressions et du code mélangé INTEGER/DOUBLE/CHAR/BOOLEAN. La même graine
+// donne toujours le même programme (générateur pseudo-aléatoire xorshift, pas rand()).
+// Le programme n'est fait que pour être compilé : ses boucles ne terminent pas forcément.
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+unsigned long long Etat;            // état du générateur xorshift64
+long Lignes = 0;                    // lignes déjà écrites
+int NbEntiers, NbDoubles, NbCaracteres, NbBooleens, NbFonctions;
+
+const int PROFONDEUR_MAX = 60;      // imbrication maximale des instructions
+
+unsigned Hasard(unsigned n) {
+    Etat ^= Etat << 13;
+    Etat ^= Etat >> 7;
+    Etat ^= Etat << 17;
+    return Etat % n;
+}
+
+void FinLigne() {
+    cout << endl;
+    Lignes++;
+}
+
+void Indente(int profondeur) {
+    cout << string(4 * profondeur, ' ');
+}
+
+string Entier()     { return "i" + to_string(Hasard(NbEntiers)); }
+string Double()     { return "d" + to_string(Hasard(NbDoubles)); }
+string Caractere()  { return "c" + to_string(Hasard(NbCaracteres)); }
+string Booleen()    { return "b" + to_string(Hasard(NbBooleens)); }
+
+// Expression entière de profondeur au plus p
+string ExpressionEntiere(int p) {
+    unsigned r = Hasard(10);
+    if (p == 0 || r < 3)
+        return r % 2 ? Entier() : to_string(Hasard(1000));
+    if (r == 3 && NbFonctions > 0)
+        return "f" + to_string(Hasard(NbFonctions)) + "(" + ExpressionEntiere(p - 1)
+             + ", " + ExpressionEntiere(p - 1) + ")";
+    const char* operateurs[] = {" + ", " - ", " * ", " / ", " % "};
+    int op = Hasard(5);
+    string droite = op >= 3 ? to_string(1 + Hasard(9)) : ExpressionEntiere(p - 1);  // pas de division par zéro
+    string e = ExpressionEntiere(p - 1) + operateurs[op] + droite;
+    return Hasard(2) ? "(" + e + ")" : e;
+}
+
+string ExpressionDouble(int p) {
+    if (p == 0 || Hasard(3) == 0)
+        return Hasard(2) ? Double() : to_string(Hasard(100)) + "." + to_string(Hasard(100));
+    const char* operateurs[] = {" + ", " - ", " * ", " / "};
+    int op = Hasard(4);
+    string droite = op == 3 ? to_string(1 + Hasard(9)) + ".5" : ExpressionDouble(p - 1);
+    return "(" + ExpressionDouble(p - 1) + operateurs[op] + droite + ")";
+}
+
+string ExpressionBooleenne(int p) {
+    const char* comparaisons[] = {" == ", " != ", " < ", " > ", " <= ", " >= "};
+    string e = "(" + ExpressionEntiere(2) + comparaisons[Hasard(6)] + ExpressionEntiere(2) + ")";
+    if (p > 0)
+        switch (Hasard(4)) {
+        case 0: return e + " && " + ExpressionBooleenne(p - 1);
+        case 1: return e + " || !" + Booleen();
+        case 2: return Booleen() + " || " + e;
+        }
+    return e;
+}
+
+// Longue expression sur plusieurs lignes : i := 1 + i3 * 2 - ...
+void LongueExpression(int profondeur, bool indente) {
+    if (indente)
+        Indente(profondeur);
+    cout << Entier() << " := ";
+    int n = 50 + Hasard(250);
+    const char* operateurs[] = {" +", " *", " -", " +"};
+    for (int k = 0; k < n; k++) {
+        if (k > 0) {
+            cout << operateurs[Hasard(4)];
+            if (k % 12 == 0) {
+                FinLigne();
+                Indente(profondeur + 2);
+            }
+            else
+                cout << " ";
+        }
+        cout << (Hasard(2) ? Entier() : to_string(1 + Hasard(9)));
+    }
+}
+
+void Instruction(int profondeur, bool indente = true);
+
+// BEGIN i1; i2; ... END
+void Bloc(int profondeur, int nb) {
+    cout << "BEGIN";
+    FinLigne();
+    for (int k = 0; k < nb; k++) {
+        Instruction(profondeur + 1);
+        if (k + 1 < nb) cout << ";";
+        FinLigne();
+    }
+    Indente(profondeur);
+    cout << "END";
+}
+
+// Pyramide de blocs : BEGIN BEGIN BEGIN ... END END END
+void Pyramide(int profondeur, int hauteur, bool indente) {
+    if (indente)
+        Indente(profondeur);
+    for (int k = 0; k < hauteur; k++)
+        cout << "BEGIN ";
+    FinLigne();
+    Instruction(profondeur + 1);
+    FinLigne();
+    Indente(profondeur);
+    for (int k = 0; k < hauteur; k++)
+        cout << (k ? " END" : "END");
+}
+
+// indente : false quand l'instruction suit une étiquette du CASE sur la même ligne
+void Instruction(int profondeur, bool indente) {
+    unsigned r = Hasard(100);
+    bool composee = profondeur < PROFONDEUR_MAX;
+    if (composee && r < 1) {
+        Pyramide(profondeur, 20 + Hasard(80), indente);
+        return;
+    }
+    if (composee && r < 3) {
+        LongueExpression(profondeur, indente);
+        return;
+    }
+    if (indente)
+        Indente(profondeur);
+    if (composee && r < 12)
+        Bloc(profondeur, 1 + Hasard(4));
+    else if (composee && r < 20) {
+        cout << "IF " << ExpressionBooleenne(2) << " THEN";
+        FinLigne();
+        Instruction(profondeur + 1);
+        if (Hasard(2)) {
+            FinLigne();
+            Indente(profondeur);
+            cout << "ELSE";
+            FinLigne();
+            Instruction(profondeur + 1);
+        }
+    }
+    else if (composee && r < 25) {
+        cout << "WHILE " << ExpressionBooleenne(1) << " DO";
+        FinLigne();
+        Instruction(profondeur + 1);
+    }
+    else if (composee && r < 30) {
+        cout << "FOR " << Entier() << " := " << ExpressionEntiere(1) << " TO " << ExpressionEntiere(2) << " DO";
+        FinLigne();
+        Instruction(profondeur + 1);
+    }
+    else if (composee && r < 34) {
+        cout << "CASE " << ExpressionEntiere(1) << " OF";
+        FinLigne();
+        int valeur = Hasard(10), nb = 2 + Hasard(6);
+        for (int k = 0; k < nb; k++) {
+            Indente(profondeur + 1);
+            if (Hasard(3) == 0) {
+                cout << valeur << ".." << valeur + 1 + Hasard(5);
+                valeur += 7;
+            } else
+                cout << valeur++;
+            cout << ": ";
+            valeur += Hasard(4);
+            Instruction(profondeur + 2, false);
+            if (k + 1 < nb) cout << ";";
+            FinLigne();
+        }
+        Indente(profondeur);
+        if (Hasard(2)) {
+            cout << "ELSE ";
+            Instruction(profondeur + 2, false);
+            FinLigne();
+            Indente(profondeur);
+        }
+        cout << "END";
+    }
+    else if (r < 40)
+        cout << "DISPLAY " << ExpressionEntiere(2);
+    else if (r < 52)
+        cout << Double() << " := " << ExpressionDouble(3);
+    else if (r < 58)
+        cout << Caractere() << " := " << (Hasard(2) ? Caractere() : string("'") + char('a' + Hasard(26)) + "'");
+    else if (r < 68)
+        cout << Booleen() << " := " << ExpressionBooleenne(2);
+    else
+        cout << Entier() << " := " << ExpressionEntiere(4);
+}
+
+// VAR v0, v1, ... : TYPE (dix noms par ligne)
+void Declarations(char prefixe, int nb, const char* type, bool derniere) {
+    for (int k = 0; k < nb; k++) {
+        if (k % 10 == 0) {
+            if (k > 0) {
+                cout << ",";
+                FinLigne();
+            }
+            cout << "    ";
+        }
+        else
+            cout << ", ";
+        cout << prefixe << k;
+    }
+    cout << " : " << type << (derniere ? "." : ";");
+    FinLigne();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage : " << argv[0] << " <graine> <lignes>" << endl;
+        return 1;
+    }
+    Etat = strtoull(argv[1], NULL, 10) * 2654435761ull + 1;
+    long cible = atol(argv[2]);
+
+    NbEntiers = 20 + cible / 50;
+    NbDoubles = 10 + cible / 200;
+    NbCaracteres = 5 + cible / 400;
+    NbBooleens = 5 + cible / 400;
+    NbFonctions = 1 + cible / 2000;
+
+    cout << "(* Programme généré par gen_prog, graine " << argv[1] << " *)";
+    FinLigne();
+    cout << "VAR";
+    FinLigne();
+    Declarations('i', NbEntiers, "INTEGER", false);
+    Declarations('d', NbDoubles, "DOUBLE", false);
+    Declarations('c', NbCaracteres, "CHAR", false);
+    Declarations('b', NbBooleens, "BOOLEAN", true);
+
+    // Petites fonctions, appelées depuis les expressions (expansion en ligne)
+    for (int f = 0; f < NbFonctions; f++) {
+        cout << "FUNCTION f" << f << "(x, y : INTEGER) : INTEGER;";
+        FinLigne();
+        cout << "BEGIN";
+        FinLigne();
+        cout << "    f" << f << " := x * " << 1 + Hasard(9) << " + y - " << Hasard(100);
+        FinLigne();
+        cout << "END;";
+        FinLigne();
+    }
+
+    cout << "BEGIN";
+    FinLigne();
+    while (Lignes < cible) {
+        Instruction(1);
+        if (Lignes + 1 < cible) cout << ";";
+        FinLigne();
+    }
+    cout << "END.";
+    FinLigne();
+    return 0;
+}
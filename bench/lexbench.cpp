@@ -0,0 +1,63 @@
+// Débit des deux analyseurs lexicaux, en Mo/s, sur un même fichier source
+// Usage : lexbench fichier.p [répétitions]
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <FlexLexer.h>
+#include "tokeniser_simd.h"
+
+using namespace std;
+
+// Analyse tout le texte avec un lexer ; retourne le nombre de lexèmes
+template <class Lexer>
+unsigned long Analyse(Lexer& lexer) {
+    unsigned long n = 0;
+    while (lexer.yylex() != FEOF)
+        n++;
+    return n;
+}
+
+template <class Lexer>
+void Mesure(const char* nom, const string& source, int repetitions) {
+    unsigned long lexemes = 0;
+    auto debut = chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        istringstream entree(source);
+        ostringstream echo;
+        Lexer lexer(&entree, &echo);
+        lexemes = Analyse(lexer);
+    }
+    double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    double mo = (double)source.size() * repetitions / 1e6;
+    cout << nom << "\t" << mo / secondes << " Mo/s\t"
+         << lexemes * repetitions / secondes / 1e6 << " Mlexèmes/s\t("
+         << lexemes << " lexèmes)" << endl;
+}
+
+// SimdLexer n'a pas de flux de sortie : même constructeur que yyFlexLexer
+struct SimdLexerBench : SimdLexer {
+    SimdLexerBench(istream* entree, ostream*) : SimdLexer(entree) {}
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage : " << argv[0] << " fichier.p [répétitions]" << endl;
+        return 1;
+    }
+    ifstream f(argv[1]);
+    if (!f) {
+        cerr << "Impossible d'ouvrir " << argv[1] << endl;
+        return 1;
+    }
+    string source((istreambuf_iterator<char>(f)), istreambuf_iterator<char>());
+    int repetitions = argc > 2 ? atoi(argv[2]) : 10;
+
+    cout << argv[1] << " : " << source.size() << " octets, " << repetitions << " répétitions" << endl;
+    Mesure<yyFlexLexer>("flex", source, repetitions);
+    Mesure<SimdLexerBench>(SimdLexer::JeuInstructions(), source, repetitions);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/bin/sh
+# Mesure un exécutable de benchmark.
+# Utilise les compteurs de perf stat quand perf est disponible,
+# sinon affiche seulement le temps écoulé.
+# Usage : bench/mesure.sh <exécutable> [arguments...]
+
+EVENTS=${EVENTS:-cycles,instructions,cache-misses,L1-dcache-load-misses,alignment-faults}
+
+if command -v perf >/dev/null 2>&1; then
+    perf stat -e "$EVENTS" "$@" > /dev/null
+else
+    debut=$(date +%s%N)
+    "$@" > /dev/null
+    fin=$(date +%s%N)
+    echo "$1 : $(( (fin - debut) / 1000000 )) ms (perf indisponible)"
+fi
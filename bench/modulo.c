@@ -0,0 +1,20 @@
+/* Référence C de modulo.p */
+#include <stdio.h>
+
+unsigned long long n, pairs, s;
+
+int main(void) {
+    n = 1;
+    while (n < 20000000) {
+        if (n % 2 == 0)
+            pairs = pairs + 1;
+        else
+            s = s + n % 7;
+        if (n % 3 == 0)
+            s = s + n % 10;
+        n = n + 1;
+    }
+    printf("%llu\n", pairs);
+    printf("%llu\n", s);
+    return 0;
+}
@@ -0,0 +1,18 @@
+(* Boucle chargée en modulos, comme tests/test_tp3.p *)
+VAR
+    n, pairs, s : INTEGER.
+BEGIN
+    n := 1;
+    WHILE n < 20000000 DO
+    BEGIN
+        IF n % 2 == 0 THEN
+            pairs := pairs + 1
+        ELSE
+            s := s + n % 7;
+        IF n % 3 == 0 THEN
+            s := s + n % 10;
+        n := n + 1
+    END;
+    DISPLAY pairs;
+    DISPLAY s
+END.
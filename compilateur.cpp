@@ -22,8 +22,20 @@
 #include <cstdlib>
 #include <set>
 #include <map>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
 #include <cstring>
+#include <climits>
+#include <cerrno>
+#include <chrono>
+#include <sys/resource.h>
+#ifdef USE_FLEX
 #include <FlexLexer.h>
+#else
+#include "tokeniser_simd.h"
+#endif
 #include "tokeniser.h"
 
 using namespace std;
@@ -31,12 +43,142 @@ using namespace std;
 
 // === Déclarations globales ===
 map<string, TYPES> DeclaredVars;      // on a Changer le type de DeclaredVars
-unsigned long tagID = 0;           // Pour les étiquettes Vrai/Suite
+unsigned long tagID = 0;           // numéro des étiquettes (IF, WHILE, FOR, CASE...)
 char lookedAhead;                  // Caractère look-ahead
 int NLookedAhead = 0;              // Compteur look-ahead
 
 TOKEN current;                     // Token courant
-FlexLexer* lexer = new yyFlexLexer; // Lexer Flex++
+#ifdef USE_FLEX
+typedef yyFlexLexer Lexer;         // Lexer Flex++ (référence, make LEXER=flex)
+#else
+typedef SimdLexer Lexer;           // Lexer écrit à la main (SSE2/AVX2)
+#endif
+Lexer* lexer = new Lexer;
+bool Traces = false;               // traces DEBUG de l'analyse sur cerr (--debug)
+string NomSource = "<stdin>";      // fichier source (argument), pour .file et --annotate
+
+// Directive de numéro de ligne : le code qui suit vient de cette ligne du source.
+// L'assembleur en tire les tables de lignes DWARF (.debug_line, .debug_info),
+// qu'utilisent gdb, addr2line et perf.
+string Loc(int ligne) {
+    return "\t.loc 1 " + to_string(ligne) + "\n";
+}
+
+
+
+// === Sous-programmes (PROCEDURE / FUNCTION) ===
+// Convention d'appel System V : les arguments entiers sont passés dans
+// %rdi, %rsi, %rdx, %rcx, %r8, %r9 et les DOUBLE dans %xmm0..%xmm7, les
+// suivants sur la pile (le premier à 16(%rbp) dans l'appelé) ;
+// le résultat revient dans %rax (ou %xmm0). Paramètres et variables locales
+// sont rangés dans le cadre de pile, à des décalages négatifs de %rbp.
+struct SousProgramme {
+    string nom;
+    bool fonction;                          // FUNCTION (avec résultat) ou PROCEDURE
+    TYPES retour;                           // type du résultat d'une FUNCTION
+    vector<pair<string, TYPES>> parametres;
+    vector<string> registres;               // registre de chaque paramètre ("" : passé sur la pile)
+    string code;                            // code complet : étiquette, prologue, corps, épilogue
+    unsigned long nbAppels;                 // nombre de sites d'appel restants
+};
+map<string, SousProgramme> SousProgrammes;
+vector<string> OrdreSousProgrammes;         // ordre de déclaration
+SousProgramme* SPCourant = NULL;            // sous-programme en cours d'analyse
+map<string, pair<TYPES, int>> VarsLocales;  // variable locale -> (type, décalage depuis %rbp)
+int TailleCadre = 0;                        // octets réservés dans le cadre courant
+
+// Étiquette assembleur d'un sous-programme : le préfixe "SP." (un point ne peut
+// pas apparaître dans un identificateur) évite toute collision avec main, les
+// fonctions de la libc, les variables et les étiquettes générées (ALORS1, FINIF1...)
+string EtiquetteSP(const string& nom) {
+    return "SP." + nom;
+}
+
+// Sous-programme dont l'étiquette est la cible d'un call ou d'un jmp ("" sinon)
+string SousProgrammeCible(const string& cible) {
+    if (cible.compare(0, 3, "SP.") != 0 || !SousProgrammes.count(cible.substr(3)))
+        return "";
+    return cible.substr(3);
+}
+// Valeurs intermédiaires des expressions en cours, empilées au point où le code
+// est émis : la pile est alignée sur 16 octets entre les instructions, un appel
+// placé après un nombre impair de valeurs doit la réaligner (voir AppelSousProgramme)
+unsigned long ValeursEmpilees = 0;
+
+const char* REGISTRES_ENTIERS[] = {"%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9"};
+const unsigned NB_REGISTRES_ENTIERS = 6;
+const unsigned NB_REGISTRES_FLOTTANTS = 8;
+
+// Expansion en ligne : un sous-programme non récursif est recopié à la place
+// de ses appels s'il n'est appelé qu'une fois ou si son corps est petit
+const unsigned SEUIL_EN_LIGNE = 40;         // nombre maximal d'instructions
+bool ExpansionEnLigneActive = true;         // --no-inline pour comparer
+
+// Conversion des IF en cmov : un IF dont chaque partie est une affectation
+// simple et bon marché est calculé sans saut (voir IfStatement)
+const unsigned SEUIL_CMOV = 12;             // instructions maximales par partie
+bool ConversionSiActive = true;             // --no-if-conversion pour comparer
+
+// Propagation des constantes et code mort sur le programme principal
+// (voir PropagationEtCodeMort)
+bool PropagationActive = true;              // --no-sccp pour comparer
+set<string> VariablesUtilisees;             // variables encore référencées par le code émis
+
+
+
+// === Disposition de la section de données ===
+// Les variables ne sont plus émises là où elles sont déclarées : on note leurs
+// accès pendant l'analyse, puis DataSection() les place dans .bss à la fin.
+unsigned ProfondeurBoucle = 0;          // imbrication courante des WHILE/FOR
+unsigned long BoucleCourante = 0;       // tag de la boucle la plus interne (0 = hors boucle)
+vector<string> OrdreDeclaration;        // variables dans l'ordre de déclaration
+map<string, unsigned long long> PoidsVar;   // fréquence estimée des accès
+map<string, unsigned long> BoucleMaison;    // boucle où la variable est la plus chaude
+map<string, unsigned long long> PoidsMaison; // poids des accès dans cette boucle
+
+const unsigned LIGNE_CACHE = 64;
+bool DispositionDeclaration = false;    // --layout=declaration : ancienne disposition (comparaison)
+
+
+
+// === Profil d'exécution (--profile-generate / --profile-use) ===
+// --profile-generate : un compteur de 64 bits par arête de branchement et par
+// entrée de sous-programme (IF<n>_ALORS, IF<n>_SINON, WHILE<n>_ENTREE,
+// WHILE<n>_TOUR, FOR<n>_ENTREE, FOR<n>_TOUR, APPEL_<nom>), incrémenté par un
+// simple incq : le langage n'a pas de threads, donc pas d'instruction atomique.
+// Le programme écrit ses compteurs dans le fichier de profil avant de terminer.
+// <n> est le numéro d'étiquette de l'instruction, attribué pendant l'analyse :
+// il ne dépend que du source, pas des options de compilation.
+// --profile-use : le profil décide de la disposition des IF et des seuils
+// d'expansion en ligne, et avec --unroll-loops du déroulage des boucles chaudes
+// (désactivé par défaut : aucun gain mesuré sur les noyaux de make bench-pgo).
+bool ProfilGeneration = false;
+bool ProfilUtilisation = false;
+bool DeroulageActif = false;                // --unroll-loops
+string FichierProfil = "compilateur.profil";
+vector<string> NomsCompteurs;               // compteur k (PROFIL+8k) -> clé du profil
+map<string, unsigned long long> Profil;     // clé -> nombre d'exécutions (--profile-use)
+
+const unsigned long long SEUIL_CHAUD = 10000;   // tours à partir desquels une boucle est chaude
+const unsigned DEROULAGE_MAX = 8;               // facteur de déroulage maximal
+const unsigned SEUIL_EN_LIGNE_CHAUD = 160;      // seuil d'expansion en ligne d'un appel chaud
+
+// Instruction qui incrémente le compteur de la clé donnée (vide sans --profile-generate)
+string Compteur(const string& cle) {
+    if (!ProfilGeneration)
+        return "";
+    string incq = "\tincq PROFIL+" + to_string(8 * NomsCompteurs.size()) + "(%rip)\t# " + cle + "\n";
+    NomsCompteurs.push_back(cle);
+    return incq;
+}
+
+// Vrai si le profil contient la clé ; n reçoit son nombre d'exécutions
+bool Frequence(const string& cle, unsigned long long& n) {
+    if (!ProfilUtilisation || !Profil.count(cle))
+        return false;
+    n = Profil[cle];
+    return true;
+}
 
 
 
@@ -47,7 +189,40 @@ enum OPMUL {MUL, DIV, MOD, AND, WTFM};
 
 // Vérifie si une variable est déclarée
 bool VariableConnue(const string& nom) {
-    return DeclaredVars.count(nom) != 0;
+    return VarsLocales.count(nom) != 0 || DeclaredVars.count(nom) != 0;
+}
+
+// Type d'une variable : les variables locales masquent les globales
+TYPES TypeVariable(const string& nom) {
+    if (VarsLocales.count(nom))
+        return VarsLocales[nom].first;
+    return DeclaredVars[nom];
+}
+
+// Opérande mémoire d'une variable : globale dans .bss, locale dans le cadre de pile
+string Adresse(const string& nom) {
+    if (VarsLocales.count(nom))
+        return to_string(VarsLocales[nom].second) + "(%rbp)";
+    return nom + "(%rip)";
+}
+
+// Taille en octets d'une variable du type donné
+unsigned TailleType(TYPES t) {
+    return (t == CHAR_TYPE) ? 1 : 8;
+}
+
+// Note un accès à une variable : chaque niveau de boucle compte dix fois plus
+void NoteAcces(const string& nom) {
+    if (VarsLocales.count(nom))
+        return;     // les variables locales ne sont pas dans .bss
+    unsigned long long poids = 1;
+    for (unsigned i = 0; i < ProfondeurBoucle && i < 6; i++)
+        poids *= 10;
+    PoidsVar[nom] += poids;
+    if (poids > PoidsMaison[nom]) {
+        PoidsMaison[nom] = poids;
+        BoucleMaison[nom] = BoucleCourante;
+    }
 }
 
 // Affiche une erreur personnalisée et arrête le programme
@@ -79,6 +254,7 @@ void Erreur(const string& msg) {
 // Term := Factor {MultiplicativeOperator Factor}
 // Factor := Number | Letter | "(" Expression ")"| "!" Factor
 // Number := Digit{Digit}
+// (Expression, SimpleExpression, Term et Factor sont analysés sans récursion par Expression())
 
 // AdditiveOperator := "+" | "-" | "||"
 // MultiplicativeOperator := "*" | "/" | "%" | "&&"
@@ -94,24 +270,54 @@ void Erreur(const string& msg) {
 //  Number : retourne toujours le type UNSIGNED_INT
 // Sert à vérifier que les valeurs numériques sont bien des entiers
 
+// Valeur d'un entier littéral (expression ou étiquette de CASE) : 64 bits non signés
+unsigned long long ValeurEntiere(const char* texte) {
+    errno = 0;
+    unsigned long long v = strtoull(texte, NULL, 10);
+    if (errno == ERANGE)
+        Erreur("entier trop grand (maximum 18446744073709551615)");
+    return v;
+}
+
+// Un immédiat de plus de 31 bits ne tient pas dans push/cmpq/subq : il passe
+// par un registre (movabsq)
+bool ImmediatCourt(unsigned long long v) {
+    return v <= INT_MAX;
+}
+
 TYPES Number() {
-    cout << "\tpush $" << atoi(lexer->YYText()) << endl;
+    unsigned long long v = ValeurEntiere(lexer->YYText());
+    if (ImmediatCourt(v))
+        cout << "\tpush $" << v << endl;
+    else
+        cout << "\tmovabsq $" << v << ", %rax\n\tpush %rax" << endl;
     current = (TOKEN) lexer->yylex();
     return UNSIGNED_INT;
 }
 
 
-//  Identifier : retourne le type de la variable déjà déclarée
-// Actuellement, on suppose que toutes les variables sont de type UNSIGNED_INT
+TYPES AppelSousProgramme(const string& nom);
+
+//  Identifier : retourne le type de la variable déjà déclarée,
+// ou du résultat de la fonction appelée
 
 TYPES Identifier() {
     string nom = lexer->YYText();
+    current = (TOKEN) lexer->yylex();
+    if (SousProgrammes.count(nom) && (current == LPARENT || !VariableConnue(nom))) {
+        if (!SousProgrammes[nom].fonction)
+            Erreur("La procédure '" + nom + "' ne retourne pas de valeur");
+        return AppelSousProgramme(nom);
+    }
     if (!VariableConnue(nom))
         Erreur("Variable non déclarée : " + nom);
-    cout << "\tmovq " << nom << "(%rip), %rax" << endl;
+    NoteAcces(nom);
+    if (TypeVariable(nom) == CHAR_TYPE)
+        cout << "\tmovzbq " << Adresse(nom) << ", %rax\t# lecture d'un octet" << endl;
+    else
+        cout << "\tmovq " << Adresse(nom) << ", %rax" << endl;
     cout << "\tpush %rax" << endl;
-    current = (TOKEN) lexer->yylex();
-    return DeclaredVars[nom];
+    return TypeVariable(nom);
 }
 
 
@@ -120,7 +326,13 @@ OPADD AdditiveOperator(void);
 void IfStatement();
 void WhileStatement();
 void ForStatement();
+void CaseStatement();
+void SubprogramDeclaration();
 void BlockStatement();
+vector<string> Lignes(const string& texte);
+string Texte(const vector<string>& lignes);
+unsigned NbInstructions(const vector<string>& lignes);
+vector<string> RenommeEtiquettes(const vector<string>& lignes, const string& suffixe);
 void DisplayStatement();
 
 void VarDeclaration(); 
@@ -130,33 +342,26 @@ void VarDeclarationPart();  // Prototype de la fonction
 
 
 
-//  Factor : appelle Number ou Identifier ou Expression récursivement
+//  Primaire : une valeur d'un facteur (nombre, double, caractère, variable ou appel)
+// Les parenthèses et le "!" sont gérés par Expression()
 // Retourne le type qu’il a rencontré
 
-// Analyse un facteur d'une expression (nombre, variable, parenthèses)
-TYPES Factor() {
+TYPES Primaire() {
     TYPES t;
-    if (current == RPARENT) {
-        current = (TOKEN) lexer->yylex();
-        t = Expression();
-        if (current != LPARENT)
-            Erreur("Parenthèse fermante attendue");
-        current = (TOKEN) lexer->yylex();
-    } 
-    else if (current == NUMBER) {
+    if (current == NUMBER) {
         t = Number();
     } 
     else if (current == DOUBLE_CONST_TOKEN) {  // Token
         double d = atof(lexer->YYText());
         unsigned long long *p = (unsigned long long*)&d;
-        cout << "\tsubq $8, %rsp\t\t\t# allocation 8 octets pour double" << endl;
-        cout << "\tmovq $" << *p << ", (%rsp)\t# empile double " << d << endl;
+        cout << "\tmovabsq $" << *p << ", %rax" << endl;
+        cout << "\tpush %rax\t# empile double " << d << endl;
         current = (TOKEN) lexer->yylex();
         t = DOUBLE_TYPE;   // Type
     } 
     else if (current == CHARCONST_TOKEN) {  // Token
         cout << "\tmovq $0, %rax" << endl;
-        cout << "\tmovb $" << lexer->YYText()[1] << ", %al" << endl;
+        cout << "\tmovb $" << (int)(unsigned char)lexer->YYText()[1] << ", %al" << endl;
         cout << "\tpush %rax\t# empile caractère " << lexer->YYText() << endl;
         current = (TOKEN) lexer->yylex();
         t = CHAR_TYPE;   // Type
@@ -195,118 +400,98 @@ OPMUL MultiplicativeOperator(void){
 	return opmul;
 
 }
-// Analyse un terme : une suite de facteurs liés par des opérateurs multiplicatifs
-// Term := Factor {MultiplicativeOperator Factor}
-TYPES Term() {
-    TYPES t1 = Factor();
-    while (current == MULOP) {
-        OPMUL op = MultiplicativeOperator();
-        TYPES t2 = Factor();
-        if (t1 != t2) TypeErreur("types incompatibles dans Term");
-        
-        if (t1 == DOUBLE_TYPE) {
-            // Opérations en flottant 64 bits avec la pile flottante x87
-            switch(op) {
-                case MUL:
-                    cout << "\tfldl 8(%rsp)\n";           // Charger op2 dans st(0)
-                    cout << "\tfldl (%rsp)\n";             // Charger op1 dans st(0), st(1) = op2
-                    cout << "\tfmulp %st(0), %st(1)\n";   // st(1) = st(1) * st(0), pop st(0)
-                    cout << "\tfstpl 8(%rsp)\n";           // Stocker le résultat à l'emplacement de op2
-                    cout << "\taddq $8, %rsp\n";           // Dépile op1 de la pile générale
-                    break;
-                case DIV:
-                    cout << "\tfldl (%rsp)\n";
-                    cout << "\tfldl 8(%rsp)\n";
-                    cout << "\tfdivp %st(0), %st(1)\n";
-                    cout << "\tfstpl 8(%rsp)\n";
-                    cout << "\taddq $8, %rsp\n";
-                    break;
-                default:
-                    Erreur("opérateur multiplicatif flottant non supporté");
-            }
+// Génère une opération multiplicative sur les deux valeurs au sommet de la pile
+void OperationMultiplicative(OPMUL op, TYPES t1) {
+    if (t1 == DOUBLE_TYPE) {
+        // Opérations en flottant 64 bits avec la pile flottante x87
+        switch(op) {
+            case MUL:
+                cout << "\tfldl 8(%rsp)\n";           // Charger op2 dans st(0)
+                cout << "\tfldl (%rsp)\n";             // Charger op1 dans st(0), st(1) = op2
+                cout << "\tfmulp %st(0), %st(1)\n";   // st(1) = st(1) * st(0), pop st(0)
+                cout << "\tfstpl 8(%rsp)\n";           // Stocker le résultat à l'emplacement de op2
+                cout << "\taddq $8, %rsp\n";           // Dépile op1 de la pile générale
+                break;
+            case DIV:
+                cout << "\tfldl (%rsp)\n";
+                cout << "\tfldl 8(%rsp)\n";
+                cout << "\tfdivp %st(0), %st(1)\n";
+                cout << "\tfstpl 8(%rsp)\n";
+                cout << "\taddq $8, %rsp\n";
+                break;
+            default:
+                Erreur("opérateur multiplicatif flottant non supporté");
         }
-        else {
-            // Opérations entières
-            cout << "\tpop %rbx" << endl;
-            cout << "\tpop %rax" << endl;
-            switch(op) {
-                case AND:
-                    cout << "\tmulq\t%rbx" << endl;
-                    cout << "\tpush %rax\t# AND" << endl;
-                    break;
-                case MUL:
-                    cout << "\tmulq\t%rbx" << endl;
-                    cout << "\tpush %rax\t# MUL" << endl;
-                    break;
-                case DIV:
-                    cout << "\tmovq $0, %rdx" << endl;
-                    cout << "\tdiv %rbx" << endl;
-                    cout << "\tpush %rax\t# DIV" << endl;
-                    break;
-                case MOD:
-                    cout << "\tmovq $0, %rdx" << endl;
-                    cout << "\tdiv %rbx" << endl;
-                    cout << "\tpush %rdx\t# MOD" << endl;
-                    break;
-                default:
-                    Erreur("opérateur multiplicatif attendu");
-            }
+    }
+    else {
+        // Opérations entières
+        cout << "\tpop %rbx" << endl;
+        cout << "\tpop %rax" << endl;
+        switch(op) {
+            case AND:
+                cout << "\tmulq\t%rbx" << endl;
+                cout << "\tpush %rax\t# AND" << endl;
+                break;
+            case MUL:
+                cout << "\tmulq\t%rbx" << endl;
+                cout << "\tpush %rax\t# MUL" << endl;
+                break;
+            case DIV:
+                cout << "\tmovq $0, %rdx" << endl;
+                cout << "\tdiv %rbx" << endl;
+                cout << "\tpush %rax\t# DIV" << endl;
+                break;
+            case MOD:
+                cout << "\tmovq $0, %rdx" << endl;
+                cout << "\tdiv %rbx" << endl;
+                cout << "\tpush %rdx\t# MOD" << endl;
+                break;
+            default:
+                Erreur("opérateur multiplicatif attendu");
         }
     }
-    return t1;
 }
 
-// SimpleExpression := Term {AdditiveOperator Term}
-//  SimpleExpression : gère les +, -, ||
-// Vérifie les types des Term, retourne le type si tous identiques
-
-TYPES SimpleExpression() {
-    TYPES t1 = Term();
-    while (current == ADDOP) {
-        OPADD op = AdditiveOperator();
-        TYPES t2 = Term();
-        if (t1 != t2) TypeErreur("types incompatibles dans SimpleExpression");
-
-        if (t1 == DOUBLE_TYPE) {
-            switch(op) {
-                case ADD:
-                    cout << "\tfldl 8(%rsp)\n";
-                    cout << "\tfldl (%rsp)\n";
-                    cout << "\tfaddp %st(0), %st(1)\n";
-                    cout << "\tfstpl 8(%rsp)\n";
-                    cout << "\taddq $8, %rsp\n";
-                    break;
-                case SUB:
-                    cout << "\tfldl (%rsp)\n";
-                    cout << "\tfldl 8(%rsp)\n";
-                    cout << "\tfsubp %st(0), %st(1)\n";
-                    cout << "\tfstpl 8(%rsp)\n";
-                    cout << "\taddq $8, %rsp\n";
-                    break;
-                default:
-                    Erreur("opérateur additif flottant non supporté");
-            }
+// Génère une opération additive (+, -, ||) sur les deux valeurs au sommet de la pile
+void OperationAdditive(OPADD op, TYPES t1) {
+    if (t1 == DOUBLE_TYPE) {
+        switch(op) {
+            case ADD:
+                cout << "\tfldl 8(%rsp)\n";
+                cout << "\tfldl (%rsp)\n";
+                cout << "\tfaddp %st(0), %st(1)\n";
+                cout << "\tfstpl 8(%rsp)\n";
+                cout << "\taddq $8, %rsp\n";
+                break;
+            case SUB:
+                cout << "\tfldl (%rsp)\n";
+                cout << "\tfldl 8(%rsp)\n";
+                cout << "\tfsubp %st(0), %st(1)\n";
+                cout << "\tfstpl 8(%rsp)\n";
+                cout << "\taddq $8, %rsp\n";
+                break;
+            default:
+                Erreur("opérateur additif flottant non supporté");
         }
-        else {
-            cout << "\tpop %rbx" << endl;
-            cout << "\tpop %rax" << endl;
-            switch(op) {
-                case OR:
-                    cout << "\taddq\t%rbx, %rax\t# OR" << endl;
-                    break;
-                case ADD:
-                    cout << "\taddq\t%rbx, %rax\t# ADD" << endl;
-                    break;
-                case SUB:
-                    cout << "\tsubq\t%rbx, %rax\t# SUB" << endl;
-                    break;
-                default:
-                    Erreur("opérateur additif inconnu");
-            }
-            cout << "\tpush %rax" << endl;
+    }
+    else {
+        cout << "\tpop %rbx" << endl;
+        cout << "\tpop %rax" << endl;
+        switch(op) {
+            case OR:
+                cout << "\taddq\t%rbx, %rax\t# OR" << endl;
+                break;
+            case ADD:
+                cout << "\taddq\t%rbx, %rax\t# ADD" << endl;
+                break;
+            case SUB:
+                cout << "\tsubq\t%rbx, %rax\t# SUB" << endl;
+                break;
+            default:
+                Erreur("opérateur additif inconnu");
         }
+        cout << "\tpush %rax" << endl;
     }
-    return t1;
 }
 
 
@@ -343,25 +528,29 @@ void VarDeclaration() {
     TYPES type = Type();
 
     for (auto& nom : variables) {
-    if (DeclaredVars.count(nom))
+    if (SPCourant ? VarsLocales.count(nom) != 0 : DeclaredVars.count(nom) != 0)
         Erreur("Variable déjà déclarée : " + nom);
 
-    DeclaredVars[nom] = type;
-
     switch(type) {
         case BOOLEAN:
         case UNSIGNED_INT:
-            cout << nom << ":\t.quad 0" << endl;
-            break;
         case DOUBLE_TYPE:
-            cout << nom << ":\t.double 0.0" << endl;
-            break;
         case CHAR_TYPE:
-            cout << nom << ":\t.byte 0" << endl;
             break;
         default:
             Erreur("Type non géré en allocation mémoire");
     }
+
+    if (SPCourant) {
+        // Variable locale : une case de 8 octets du cadre, mise à zéro par le prologue
+        TailleCadre += 8;
+        VarsLocales[nom] = make_pair(type, -TailleCadre);
+        continue;
+    }
+
+    // L'allocation est faite plus tard par DataSection()
+    DeclaredVars[nom] = type;
+    OrdreDeclaration.push_back(nom);
 }
 
 }
@@ -372,13 +561,13 @@ void VarDeclarationPart() {
         Erreur("'VAR' attendu");
     
     current = (TOKEN) lexer->yylex(); // Passe 'VAR'
-    cout << "DEBUG VarDeclarationPart: current token = " << lexer->YYText() << endl;
+    if (Traces) cerr << "DEBUG VarDeclarationPart: current token = " << lexer->YYText() << endl;
 
     VarDeclaration();
 
     while (current == SEMICOLON) {
         current = (TOKEN) lexer->yylex();
-        cout << "DEBUG VarDeclarationPart loop: current token = " << lexer->YYText() << endl;
+        if (Traces) cerr << "DEBUG VarDeclarationPart loop: current token = " << lexer->YYText() << endl;
         VarDeclaration();
     }
 
@@ -386,7 +575,7 @@ void VarDeclarationPart() {
         Erreur("'.' attendu à la fin de la déclaration de variables");
 
     current = (TOKEN) lexer->yylex(); // Passe '.'
-    cout << "DEBUG VarDeclarationPart end: current token = " << lexer->YYText() << endl;
+    if (Traces) cerr << "DEBUG VarDeclarationPart end: current token = " << lexer->YYText() << endl;
 }
 
 
@@ -434,39 +623,129 @@ OPREL RelationalOperator(void) {
 
 
 
-//  Expression : gère éventuellement une comparaison entre deux expressions arithmétiques
-// Si une comparaison est faite (==, !=, <, etc.), retourne BOOLEAN
-// Sinon retourne le type de la SimpleExpression
+// Génère une comparaison des deux valeurs au sommet de la pile (résultat booléen)
+void Comparaison(OPREL oprel) {
+    cout << "\tpop %rax\n\tpop %rbx\n\tcmpq %rax, %rbx" << endl;
 
-// Expression := SimpleExpression [RelationalOperator SimpleExpression]
-// Gère une expression complète : opération simple avec comparateur optionnel (==, <, etc.)
-TYPES Expression() {
-    TYPES t1 = SimpleExpression(); // On commence par une expression simple (addition, multiplication...)
+    // setcc plutôt qu'un saut : pas de branchement dépendant des données
+    if      (oprel == EQU)  cout << "\tsete %al" << endl;
+    else if (oprel == DIFF) cout << "\tsetne %al" << endl;
+    else if (oprel == INF)  cout << "\tsetb %al" << endl;
+    else if (oprel == SUP)  cout << "\tseta %al" << endl;
+    else if (oprel == INFE) cout << "\tsetbe %al" << endl;
+    else if (oprel == SUPE) cout << "\tsetae %al" << endl;
+    else Erreur("comparateur non reconnu");
 
-        if (current == RELOP) {
-        OPREL oprel = RelationalOperator();
-        TYPES t2 = SimpleExpression();
-        if (t1 != t2) TypeErreur("types incompatibles pour la comparaison");
+    cout << "\tmovzbq %al, %rax\n\tnegq %rax\t# vrai = -1, faux = 0\n\tpush %rax" << endl;
+}
 
-        cout << "\tpop %rax\n\tpop %rbx\n\tcmpq %rax, %rbx" << endl;
-        string tag = to_string(++tagID);
 
-        if      (oprel == EQU)  cout << "\tje Vrai" << tag << endl;
-        else if (oprel == DIFF) cout << "\tjne Vrai" << tag << endl;
-        else if (oprel == INF)  cout << "\tjb Vrai" << tag << endl;
-        else if (oprel == SUP)  cout << "\tja Vrai" << tag << endl;
-        else if (oprel == INFE) cout << "\tjbe Vrai" << tag << endl;
-        else if (oprel == SUPE) cout << "\tjae Vrai" << tag << endl;
-        else Erreur("comparateur non reconnu");
+// Opérateur en attente sur la pile de l'analyseur d'expressions
+struct OperateurEnAttente {
+    TOKEN famille;      // RELOP, ADDOP, MULOP, LPARENT (parenthèse ouverte) ou NOT
+    int op;             // OPREL, OPADD ou OPMUL selon la famille
+};
 
-        cout << "\tpush $0\n\tjmp Suite" << tag << endl;
-        cout << "Vrai" << tag << ":\tpush $-1\nSuite" << tag << ":" << endl;
+// Priorité d'un opérateur binaire (0 : n'est pas un opérateur binaire)
+int Priorite(TOKEN famille) {
+    switch (famille) {
+        case RELOP: return 1;
+        case ADDOP: return 2;
+        case MULOP: return 3;
+        default:    return 0;
+    }
+}
 
-        return BOOLEAN;  // ✅ ici uniquement si on fait une comparaison
+// Applique l'opérateur binaire du sommet aux deux derniers opérandes
+void Reduit(vector<OperateurEnAttente>& operateurs, vector<TYPES>& types) {
+    OperateurEnAttente o = operateurs.back();
+    operateurs.pop_back();
+    TYPES t2 = types.back();
+    types.pop_back();
+    TYPES t1 = types.back();
+
+    switch (o.famille) {
+        case MULOP:
+            if (t1 != t2) TypeErreur("types incompatibles dans Term");
+            OperationMultiplicative((OPMUL) o.op, t1);
+            break;
+        case ADDOP:
+            if (t1 != t2) TypeErreur("types incompatibles dans SimpleExpression");
+            OperationAdditive((OPADD) o.op, t1);
+            break;
+        default:
+            if (t1 != t2) TypeErreur("types incompatibles pour la comparaison");
+            Comparaison((OPREL) o.op);
+            types.back() = BOOLEAN;
     }
+}
+
+// Applique les "!" en attente juste au-dessus de l'opérande qui vient d'être lu
+void ReduitNon(vector<OperateurEnAttente>& operateurs, vector<TYPES>& types) {
+    while (!operateurs.empty() && operateurs.back().famille == NOT) {
+        operateurs.pop_back();
+        if (types.back() != BOOLEAN) TypeErreur("'!' s'applique à un booléen");
+        cout << "\tpop %rax\n\tnotq %rax\n\tpush %rax\t# NOT" << endl;
+    }
+}
+
+//  Expression : analyse par priorité d'opérateurs (Pratt / precedence climbing)
+// avec des piles explicites au lieu de la récursion Expression → SimpleExpression
+// → Term → Factor. La profondeur des parenthèses n'est limitée que par la
+// mémoire (une entrée par parenthèse ouverte) et chaque token est traité une fois.
+// Le code est émis dans le même ordre qu'avec la descente récursive.
+// Une comparaison donne BOOLEAN ; sinon le type commun des opérandes.
+TYPES Expression() {
+    vector<OperateurEnAttente> operateurs;
+    vector<TYPES> types;                            // une valeur empilée par opérande en attente
+    unsigned long parenthesesOuvertes = 0;
+    unsigned long empilees = ValeursEmpilees;
+
+    for (;;) {
+        // Attente d'un opérande : préfixes "!" et "(" puis une valeur
+        while (current == NOT || current == LPARENT) {
+            if (current == LPARENT) parenthesesOuvertes++;
+            operateurs.push_back({current, 0});
+            current = (TOKEN) lexer->yylex();
+        }
+        ValeursEmpilees = empilees + types.size();
+        types.push_back(Primaire());
+        ReduitNon(operateurs, types);
+
+        // ")" ferme la parenthèse ouverte la plus proche ; celle d'un appel
+        // (parenthesesOuvertes == 0) termine l'expression
+        while (current == RPARENT && parenthesesOuvertes > 0) {
+            while (operateurs.back().famille != LPARENT)
+                Reduit(operateurs, types);
+            operateurs.pop_back();
+            parenthesesOuvertes--;
+            current = (TOKEN) lexer->yylex();
+            ReduitNon(operateurs, types);
+        }
 
-    return t1;  // ✅ sinon, on renvoie le type de la SimpleExpression (ex: a+1 => UNSIGNED_INT)
+        // Attente d'un opérateur binaire ; sinon l'expression est finie
+        int priorite = Priorite(current);
+        if (priorite == 0)
+            break;
+        while (!operateurs.empty() && Priorite(operateurs.back().famille) >= priorite) {
+            if (current == RELOP && operateurs.back().famille == RELOP)
+                Erreur("comparaisons enchaînées : parenthèses nécessaires");
+            Reduit(operateurs, types);
+        }
 
+        OperateurEnAttente o = {current, 0};
+        if (current == MULOP)      o.op = MultiplicativeOperator();
+        else if (current == ADDOP) o.op = AdditiveOperator();
+        else                       o.op = RelationalOperator();
+        operateurs.push_back(o);
+    }
+
+    if (parenthesesOuvertes > 0)
+        Erreur("Parenthèse fermante attendue");
+    while (!operateurs.empty())
+        Reduit(operateurs, types);
+    ValeursEmpilees = empilees;
+    return types.back();
 }
 
 
@@ -517,7 +796,13 @@ void AssignementStatement(void) {
 
     Expression();
 
-    cout << "\tpop " << nomVar << endl;
+    NoteAcces(nomVar);
+    if (TypeVariable(nomVar) == CHAR_TYPE) {
+        cout << "\tpop %rax" << endl;
+        cout << "\tmovb %al, " << Adresse(nomVar) << "\t# écriture d'un octet" << endl;
+    }
+    else
+        cout << "\tpop " << Adresse(nomVar) << endl;
 }
 
 
@@ -538,15 +823,27 @@ int GetKeyword() {
     if (kw == "INTEGER") return INTEGER_;
     if (kw == "CHAR") return CHAR_KEYWORD_;
     if (kw == "DOUBLE") return DOUBLE_KEYWORD_;
+    if (kw == "CASE") return CASE_;
+    if (kw == "OF") return OF_;
+    if (kw == "PROCEDURE") return PROCEDURE_;
+    if (kw == "FUNCTION") return FUNCTION_;
 
-    cout << "DEBUG GetKeyword : mot inconnu -> '" << kw << "'" << endl;
+    if (Traces) cerr << "DEBUG GetKeyword : mot inconnu -> '" << kw << "'" << endl;
     return UNKNOWN_KEYWORD;
 }
 
 
 // Ajoute la prise en compte de VAR dans Statement()
 void Statement() {
-    if (current == ID) {
+    if (current != MOTCLE || GetKeyword() != BEGIN_)     // un bloc n'a pas de code propre
+        cout << Loc(lexer->lineno());
+    if (current == ID && SousProgrammes.count(lexer->YYText()) && !VariableConnue(lexer->YYText())) {
+        string nom = lexer->YYText();
+        current = (TOKEN) lexer->yylex();
+        AppelSousProgramme(nom);
+        if (SousProgrammes[nom].fonction)
+            cout << "\taddq $8, %rsp\t# résultat ignoré" << endl;
+    } else if (current == ID) {
         AssignementStatement();
     } else if (current == MOTCLE) {
         int kw = GetKeyword();
@@ -563,6 +860,9 @@ void Statement() {
             case FOR_:
                 ForStatement();
                 break;
+            case CASE_:
+                CaseStatement();
+                break;
             case BEGIN_:
                 BlockStatement();
                 break;
@@ -584,10 +884,71 @@ void Statement() {
 
 
 
+// Vrai si la ligne est une instruction de calcul sans effet hors de la pile :
+// ni saut, ni appel, ni division (qui peut échouer), ni écriture en mémoire
+// ailleurs que sur la pile, ni changement du cadre (%rbp, movq vers %rsp)
+bool InstructionPure(const string& l) {
+    static const set<string> permises = {
+        "push", "pop", "movq", "movabsq", "movzbq", "addq", "subq", "mulq", "negq", "notq", "cmpq",
+        "sete", "setne", "setb", "seta", "setbe", "setae", "cmove", "cmovne",
+        "fldl", "fstpl", "faddp", "fsubp", "fmulp"
+    };
+    if (l.empty() || l[0] != '\t')
+        return false;                           // étiquette
+    size_t fin = l.find_first_of(" \t", 1);
+    if (!permises.count(l.substr(1, fin == string::npos ? string::npos : fin - 1)))
+        return false;
+    // seule la pile peut être écrite (destination après la dernière virgule, ou pop)
+    size_t virgule = l.rfind(',');
+    string destination = l.compare(0, 5, "\tpop ") == 0 ? l.substr(5)
+                       : virgule == string::npos ? "" : l.substr(virgule + 1);
+    destination = destination.substr(0, destination.find('#'));
+    destination.erase(0, destination.find_first_not_of(" \t"));
+    destination.erase(destination.find_last_not_of(" \t") + 1);
+    if (destination.find("(%rip)") != string::npos || destination.find("%rbp") != string::npos)
+        return false;                           // variable, ou cadre d'un sous-programme
+    if (destination == "%rsp")                  // seuls addq/subq sur %rsp dépilent ou réservent
+        return l.compare(0, 6, "\taddq ") == 0 || l.compare(0, 6, "\tsubq ") == 0;
+    return true;
+}
+
+// Vrai si le code d'une partie de IF est une affectation simple qui peut être
+// exécutée même quand la condition ne la choisit pas : un calcul sans saut,
+// sans appel, sans division (qui peut échouer) ni écriture en mémoire, suivi
+// d'un "pop" vers une variable de 8 octets. Au-delà de SEUIL_CMOV instructions,
+// calculer les deux parties coûte plus cher qu'un saut mal prédit.
+// calcul reçoit le code qui empile la valeur, adresse la variable affectée.
+bool AffectationSimple(const string& code, string& calcul, string& adresse) {
+    vector<string> lignes;
+    for (auto& l : Lignes(code))
+        if (l.compare(0, 5, "\t.loc") != 0)
+            lignes.push_back(l);
+    if (lignes.empty() || lignes.back().compare(0, 5, "\tpop ") != 0)
+        return false;
+    adresse = lignes.back().substr(5);
+    if (adresse[0] == '%' || NbInstructions(lignes) > SEUIL_CMOV)
+        return false;
+    lignes.pop_back();
+
+    calcul.clear();
+    for (auto& l : lignes) {
+        if (!InstructionPure(l))
+            return false;
+        calcul += l + "\n";
+    }
+    return true;
+}
+
+
 // Gère une instruction conditionnelle IF avec option ELSE
 // Syntaxe : IF <expression> THEN <instruction> [ELSE <instruction>]
+// Une affectation simple de chaque côté devient un cmov (voir AffectationSimple),
+// sauf si le profil montre que le branchement est prévisible.
+// Avec un profil, la partie la plus fréquente suit le test sans saut ; une
+// partie ALORS rare sans SINON est placée dans la section .text.froid.
 void IfStatement() {
     unsigned long numTag = ++tagID;
+    string cle = "IF" + to_string(numTag);
 
     // Vérifie le mot-clé IF
     if (current != MOTCLE || GetKeyword() != IF_)
@@ -600,10 +961,9 @@ void IfStatement() {
     TYPES tcond = Expression();
     if (tcond != BOOLEAN) TypeErreur("La condition d’un IF doit être booléenne");
 
-
-    // Génère le code pour vérifier si la condition est fausse (== 0)
-    cout << "\tpop %rax\n\tcmpq $0, %rax\n";
-    cout << "\tje ELSE" << numTag << endl;
+    // Le test (condition fausse si == 0) est émis avec les deux parties :
+    // la conversion en cmov garde la condition sur la pile
+    string test = "\tpop %rax\n\tcmpq $0, %rax\n";
 
     // Vérifie et passe THEN
     if (current != MOTCLE || GetKeyword() != THEN_)
@@ -611,16 +971,80 @@ void IfStatement() {
 
     current = (TOKEN) lexer->yylex();  // Passe THEN
 
-    // Partie exécutée si condition vraie
-    Statement();
-    cout << "\tjmp FINIF" << numTag << endl;
-
-    // Partie exécutée si condition fausse
-    cout << "ELSE" << numTag << ":" << endl;
+    // Les deux parties sont générées dans des tampons, puis placées selon le profil
+    ostringstream alors, sinon;
+    streambuf* sortie = cout.rdbuf(alors.rdbuf());
+    cout << Compteur(cle + "_ALORS");
+    Statement();                        // partie exécutée si condition vraie
 
-    if (current == MOTCLE && GetKeyword() == ELSE_) {
+    cout.rdbuf(sinon.rdbuf());
+    cout << Compteur(cle + "_SINON");
+    bool avecSinon = (current == MOTCLE && GetKeyword() == ELSE_);
+    if (avecSinon) {
         current = (TOKEN) lexer->yylex();  // Passe ELSE
-        Statement();
+        Statement();                    // partie exécutée si condition fausse
+    }
+    cout.rdbuf(sortie);
+
+    unsigned long long nAlors, nSinon;
+    bool profil = Frequence(cle + "_ALORS", nAlors) && Frequence(cle + "_SINON", nSinon);
+    // Un branchement que le profil montre presque toujours pris du même côté
+    // est bien prédit : le saut coûte moins que le calcul des deux parties
+    bool previsible = profil && min(nAlors, nSinon) * 10 < nAlors + nSinon;
+
+    string calculAlors, adresseAlors, calculSinon, adresseSinon;
+    if (ConversionSiActive && !previsible
+        && AffectationSimple(alors.str(), calculAlors, adresseAlors)
+        && (!avecSinon || AffectationSimple(sinon.str(), calculSinon, adresseSinon))) {
+        // Sans saut : les deux valeurs sont calculées, cmov choisit la bonne.
+        // Sans SINON, la variable garde son ancienne valeur si la condition est fausse.
+        cout << "\t# IF" << numTag << " converti en cmov" << endl;
+        cout << calculAlors << calculSinon;
+        if (avecSinon)
+            cout << "\tpop %rcx\t# valeur SINON" << endl;
+        cout << "\tpop %rdx\t# valeur ALORS" << endl;
+        cout << test;
+        if (!avecSinon || adresseSinon == adresseAlors) {
+            if (!avecSinon)
+                cout << "\tmovq " << adresseAlors << ", %rcx" << endl;
+            cout << "\tcmovne %rdx, %rcx" << endl;
+            cout << "\tmovq %rcx, " << adresseAlors << endl;
+        }
+        else {
+            cout << "\tmovq " << adresseAlors << ", %rsi" << endl;
+            cout << "\tcmovne %rdx, %rsi" << endl;
+            cout << "\tmovq %rsi, " << adresseAlors << endl;
+            cout << "\tmovq " << adresseSinon << ", %rdi" << endl;
+            cout << "\tcmove %rcx, %rdi" << endl;
+            cout << "\tmovq %rdi, " << adresseSinon << endl;
+        }
+        return;
+    }
+
+    cout << test;
+    if (profil && nSinon > nAlors && avecSinon) {
+        // Branche inversée : la partie SINON, la plus fréquente, suit le test sans saut
+        cout << "\tjne ALORS" << numTag << endl;
+        cout << sinon.str();
+        cout << "\tjmp FINIF" << numTag << endl;
+        cout << "ALORS" << numTag << ":" << endl;
+        cout << alors.str();
+    }
+    else if (profil && nSinon > nAlors) {
+        // Partie ALORS la moins fréquente, sans SINON : placée hors du chemin chaud
+        cout << "\tjne ALORS" << numTag << endl;
+        cout << "\t.pushsection .text.froid,\"ax\",@progbits" << endl;
+        cout << "ALORS" << numTag << ":" << endl;
+        cout << alors.str();
+        cout << "\tjmp FINIF" << numTag << endl;
+        cout << "\t.popsection" << endl;
+    }
+    else {
+        cout << "\tje ELSE" << numTag << endl;
+        cout << alors.str();
+        cout << "\tjmp FINIF" << numTag << endl;
+        cout << "ELSE" << numTag << ":" << endl;
+        cout << sinon.str();
     }
 
     // Fin de l'instruction IF
@@ -628,17 +1052,52 @@ void IfStatement() {
 }
 
 
+// Facteur de déroulage d'une boucle d'après le profil : 1 si elle est froide
+// (ou sans --unroll-loops), sinon autant de copies d'un tour que le permettent
+// la taille du tour (64 instructions en tout) et le nombre moyen de tours par entrée
+unsigned FacteurDeroulage(const string& cle, const string& tour) {
+    unsigned long long entrees, tours;
+    if (!DeroulageActif)
+        return 1;
+    if (!Frequence(cle + "_ENTREE", entrees) || !Frequence(cle + "_TOUR", tours))
+        return 1;
+    if (tours < SEUIL_CHAUD || entrees == 0)
+        return 1;
+    unsigned n = NbInstructions(Lignes(tour));
+    unsigned facteur = DEROULAGE_MAX;
+    while (facteur > 1 && (facteur * n > 64 || facteur > tours / entrees))
+        facteur /= 2;
+    return facteur;
+}
+
+// k-ième copie d'un tour de boucle déroulée, avec ses étiquettes renommées
+string CopieDeroulee(const string& tour, unsigned long tag, unsigned k) {
+    return Texte(RenommeEtiquettes(Lignes(tour), "_D" + to_string(tag) + "_" + to_string(k)));
+}
+
 
 // Gère une boucle conditionnelle WHILE
 // Syntaxe : WHILE <expression> DO <instruction>
+// Une boucle chaude du profil est déroulée : le test et le corps sont recopiés
+// plusieurs fois avant le saut de retour.
 void WhileStatement() {
     unsigned long tag = ++tagID;
+    string cle = "WHILE" + to_string(tag);
+    int ligne = lexer->lineno();
 
     if (GetKeyword() != WHILE_) Erreur("Mot-clé 'WHILE' attendu");
     current = (TOKEN) lexer->yylex();
 
     // Début de la boucle
+    cout << Compteur(cle + "_ENTREE");
     cout << "DEBUTWHILE" << tag << ":" << endl;
+    unsigned long boucleEnglobante = BoucleCourante;
+    BoucleCourante = tag;
+    ProfondeurBoucle++;
+
+    // Un tour de boucle (test et corps) est généré dans un tampon
+    ostringstream tour;
+    streambuf* sortie = cout.rdbuf(tour.rdbuf());
 
     // Évaluation de la condition
 
@@ -652,18 +1111,57 @@ void WhileStatement() {
     current = (TOKEN) lexer->yylex();
 
     // Corps de la boucle
+    cout << Compteur(cle + "_TOUR");
     Statement();
+    cout << Loc(ligne);
+    cout.rdbuf(sortie);
+
+    unsigned facteur = FacteurDeroulage(cle, tour.str());
+    cout << tour.str();
+    for (unsigned k = 1; k < facteur; k++)
+        cout << CopieDeroulee(tour.str(), tag, k);
     cout << "\tjmp DEBUTWHILE" << tag << endl;
+    ProfondeurBoucle--;
+    BoucleCourante = boucleEnglobante;
 
     // Fin de boucle
     cout << "FINWHILE" << tag << ":" << endl;
 }
 
 
+// Vrai si le code empile une constante ("\tpush $N") ; N reçoit l'opérande "$N"
+bool BorneConstante(const string& code, string& n) {
+    if (code.compare(0, 7, "\tpush $") != 0 || code.find('\n') != code.size() - 1)
+        return false;
+    n = code.substr(6, code.size() - 7);
+    return n.find_first_not_of("$-0123456789") == string::npos;
+}
+
+// Vrai si le code peut modifier la variable d'adresse donnée : écriture
+// (destination d'une instruction, pop, incq) ou appel d'un sous-programme
+bool ModifieVariable(const string& code, const string& adresse) {
+    for (auto& l : Lignes(code)) {
+        if (l.compare(0, 6, "\tcall ") == 0 && !SousProgrammeCible(l.substr(6)).empty())
+            return true;
+        size_t p = l.find(adresse);
+        if (p == string::npos)
+            continue;
+        if (l.compare(0, 5, "\tpop ") == 0 || l.compare(0, 6, "\tincq ") == 0
+            || l.find(',') < p)
+            return true;
+    }
+    return false;
+}
+
 // Gère une boucle FOR à incrémentation
 // Syntaxe : FOR <assignation> TO <expression> DO <instruction>
+// Une boucle chaude du profil est déroulée. Si la borne est constante et que
+// le corps ne modifie pas la variable, un seul test couvre un bloc de tours ;
+// les derniers tours sont faits un par un.
 void ForStatement() {
     unsigned long tag = ++tagID;
+    string cle = "FOR" + to_string(tag);
+    int ligne = lexer->lineno();
 
     if (GetKeyword() != FOR_) Erreur("'FOR' attendu");
     current = (TOKEN) lexer->yylex();
@@ -674,28 +1172,281 @@ void ForStatement() {
     if (current != MOTCLE || GetKeyword() != TO_) Erreur("'TO' attendu après FOR");
     current = (TOKEN) lexer->yylex();
 
+    cout << Compteur(cle + "_ENTREE");
     cout << "DEBUTFOR" << tag << ":" << endl;
-
-
-
+    unsigned long boucleEnglobante = BoucleCourante;
+    BoucleCourante = tag;
+    ProfondeurBoucle++;
+    NoteAcces(var);
+
+    // La borne et le corps sont générés dans des tampons
+    ostringstream borne, corps;
+    streambuf* sortie = cout.rdbuf(borne.rdbuf());
     TYPES tmax = Expression();
     if (tmax != UNSIGNED_INT) TypeErreur("La borne du FOR doit être un entier non signé");
 
-    cout << "\tpop %rax" << endl;                    // TO -> rax
-    cout << "\tcmpq %rax, " << var << endl;         // compare i > TO ?
-    cout << "\tja FINFOR" << tag << endl;
-
     if (current != MOTCLE || GetKeyword() != DO_) Erreur("'DO' attendu après TO");
     current = (TOKEN) lexer->yylex();
 
+    cout.rdbuf(corps.rdbuf());
+    cout << Compteur(cle + "_TOUR");
     Statement();
-
-    cout << "\tincq " << var << "\n\tjmp DEBUTFOR" << tag << endl;
+    cout.rdbuf(sortie);
+
+    string adresse = Adresse(var);
+    string test = borne.str()
+                + "\tpop %rax\n"                               // TO -> rax
+                + "\tcmpq %rax, " + adresse + "\n"               // compare i > TO ?
+                + "\tja FINFOR" + to_string(tag) + "\n";
+    string suite = corps.str() + Loc(ligne) + "\tincq " + adresse + "\n";
+    unsigned facteur = FacteurDeroulage(cle, test + suite);
+    string n;
+
+    if (facteur > 1 && BorneConstante(borne.str(), n) && !ModifieVariable(corps.str(), adresse)) {
+        // Bloc de "facteur" tours tant que i + facteur - 1 <= N
+        cout << "\tmovq " << adresse << ", %rax" << endl;
+        cout << "\taddq $" << facteur - 1 << ", %rax" << endl;
+        cout << "\tjc RESTEFOR" << tag << endl;
+        cout << "\tcmpq " << n << ", %rax" << endl;
+        cout << "\tja RESTEFOR" << tag << endl;
+        for (unsigned k = 1; k <= facteur; k++)
+            cout << CopieDeroulee(suite, tag, k);
+        cout << "\tjmp DEBUTFOR" << tag << endl;
+        // Derniers tours, un par un
+        cout << "RESTEFOR" << tag << ":" << endl;
+        cout << test << suite;
+        cout << "\tjmp RESTEFOR" << tag << endl;
+    }
+    else {
+        cout << test << suite;
+        for (unsigned k = 1; k < facteur; k++)
+            cout << CopieDeroulee(test + suite, tag, k);
+        cout << "\tjmp DEBUTFOR" << tag << endl;
+    }
+    ProfondeurBoucle--;
+    BoucleCourante = boucleEnglobante;
     cout << "FINFOR" << tag << ":" << endl;
 }
 
 
 
+// Un intervalle de valeurs du CASE et la branche où il mène
+struct IntervalleCase {
+    unsigned long long bas, haut;
+    string cible;
+};
+
+// Seuils de choix de l'aiguillage
+const unsigned CASE_MIN_TABLE = 4;       // nombre minimal d'intervalles pour une table de sauts
+const unsigned CASE_DENSITE_TABLE = 40;  // pourcentage minimal de valeurs utilisées dans la table
+const unsigned CASE_MAX_TABLE = 4096;    // nombre maximal d'entrées de la table
+const unsigned CASE_MAX_CIBLES_BITS = 3; // nombre maximal de branches pour les tests de bits
+
+// Valeur d'une étiquette du CASE : un entier ou un caractère du type du sélecteur
+unsigned long long EtiquetteCase(TYPES tsel) {
+    unsigned long long v;
+    if (current == NUMBER && tsel == UNSIGNED_INT)
+        v = ValeurEntiere(lexer->YYText());
+    else if (current == CHARCONST_TOKEN && tsel == CHAR_TYPE)
+        v = (unsigned char)lexer->YYText()[1];
+    else {
+        TypeErreur("étiquette du CASE attendue, du type du sélecteur");
+        return 0;
+    }
+    current = (TOKEN) lexer->yylex();
+    return v;
+}
+
+// cmpq $v, %rax, par %rdx quand v ne tient pas dans un immédiat
+void CompareSelecteur(unsigned long long v) {
+    if (ImmediatCourt(v))
+        cout << "\tcmpq $" << v << ", %rax" << endl;
+    else
+        cout << "\tmovabsq $" << v << ", %rdx\n\tcmpq %rdx, %rax" << endl;
+}
+
+// Arbre de décision binaire sur les intervalles triés [debut, fin[
+// min et max sont les bornes déjà garanties pour %rax par les comparaisons précédentes
+void ArbreCase(const vector<IntervalleCase>& iv, size_t debut, size_t fin,
+               unsigned long long min, unsigned long long max,
+               const string& sinon, unsigned long tag, unsigned long& noeud) {
+    if (fin - debut == 1) {
+        const IntervalleCase& i = iv[debut];
+        if (i.bas > min) {
+            CompareSelecteur(i.bas);
+            cout << "\tjb " << sinon << endl;
+        }
+        if (i.haut < max) {
+            CompareSelecteur(i.haut);
+            cout << "\tja " << sinon << endl;
+        }
+        cout << "\tjmp " << i.cible << endl;
+        return;
+    }
+    size_t milieu = (debut + fin) / 2;
+    string gauche = "CASE" + to_string(tag) + "_N" + to_string(++noeud);
+    CompareSelecteur(iv[milieu].bas);
+    cout << "\tjb " << gauche << endl;
+    ArbreCase(iv, milieu, fin, iv[milieu].bas, max, sinon, tag, noeud);
+    cout << gauche << ":" << endl;
+    ArbreCase(iv, debut, milieu, min, iv[milieu].bas - 1, sinon, tag, noeud);
+}
+
+// Gère une instruction à choix multiples
+// Syntaxe : CASE <expression> OF <étiquettes> : <instruction> { ; <étiquettes> : <instruction> } [ELSE <instruction>] END
+//           <étiquettes> := <valeur> [.. <valeur>] { , <valeur> [.. <valeur>] }
+// Les branches sont générées d'abord ; l'aiguillage, placé après elles, est choisi
+// selon la répartition des valeurs : table de sauts dans .rodata si elles sont denses,
+// tests de bits si elles tiennent dans 64 bits avec peu de branches, sinon arbre binaire.
+void CaseStatement() {
+    unsigned long tag = ++tagID;
+    string fin = "FINCASE" + to_string(tag);
+    string sinon = "CASEELSE" + to_string(tag);
+
+    if (GetKeyword() != CASE_) Erreur("'CASE' attendu");
+    current = (TOKEN) lexer->yylex();
+
+    TYPES tsel = Expression();
+    if (tsel != UNSIGNED_INT && tsel != CHAR_TYPE)
+        TypeErreur("Le sélecteur d'un CASE doit être un entier ou un caractère");
+
+    if (current != MOTCLE || GetKeyword() != OF_) Erreur("'OF' attendu après CASE");
+    current = (TOKEN) lexer->yylex();
+
+    cout << "\tpop %rax\t# sélecteur du CASE" << endl;
+    cout << "\tjmp CASE" << tag << "\t# aiguillage après les branches" << endl;
+
+    vector<IntervalleCase> intervalles;
+    unsigned long nbBranches = 0;
+
+    while (!(current == MOTCLE && (GetKeyword() == END_ || GetKeyword() == ELSE_))) {
+        string cible = "CASE" + to_string(tag) + "_" + to_string(++nbBranches);
+        for (;;) {
+            IntervalleCase i;
+            i.bas = i.haut = EtiquetteCase(tsel);
+            if (current == DOTDOT) {
+                current = (TOKEN) lexer->yylex();
+                i.haut = EtiquetteCase(tsel);
+                if (i.haut < i.bas) Erreur("intervalle vide dans le CASE");
+            }
+            i.cible = cible;
+            intervalles.push_back(i);
+            if (current != COMMA) break;
+            current = (TOKEN) lexer->yylex();
+        }
+        if (current != COLON) Erreur("':' attendu après les étiquettes du CASE");
+        current = (TOKEN) lexer->yylex();
+
+        cout << cible << ":" << endl;
+        Statement();
+        cout << "\tjmp " << fin << endl;
+
+        if (current == SEMICOLON)
+            current = (TOKEN) lexer->yylex();
+    }
+
+    cout << sinon << ":" << endl;
+    if (GetKeyword() == ELSE_) {
+        current = (TOKEN) lexer->yylex();
+        if (current != MOTCLE || GetKeyword() != END_)   // ELSE vide autorisé
+            Statement();
+        if (current == SEMICOLON)
+            current = (TOKEN) lexer->yylex();
+    }
+    cout << "\tjmp " << fin << endl;
+
+    if (current != MOTCLE || GetKeyword() != END_) Erreur("'END' attendu pour fermer le CASE");
+    current = (TOKEN) lexer->yylex();
+
+    // === Aiguillage ===
+    cout << "CASE" << tag << ":" << endl;
+    if (intervalles.empty()) {
+        cout << "\tjmp " << sinon << endl;
+        cout << fin << ":" << endl;
+        return;
+    }
+
+    sort(intervalles.begin(), intervalles.end(),
+         [](const IntervalleCase& a, const IntervalleCase& b) { return a.bas < b.bas; });
+    for (size_t k = 1; k < intervalles.size(); k++)
+        if (intervalles[k].bas <= intervalles[k - 1].haut)
+            Erreur("valeur " + to_string(intervalles[k].bas) + " présente deux fois dans le CASE");
+
+    // Fusion des intervalles contigus qui mènent à la même branche
+    vector<IntervalleCase> iv;
+    for (auto& i : intervalles) {
+        if (!iv.empty() && iv.back().cible == i.cible && iv.back().haut + 1 == i.bas)
+            iv.back().haut = i.haut;
+        else
+            iv.push_back(i);
+    }
+
+    // ecart = max - min, l'étendue moins un : l'étendue elle-même déborde quand
+    // les étiquettes couvrent les 2^64 valeurs ; elle n'est calculée qu'après
+    // avoir vérifié que l'écart est petit
+    unsigned long long min = iv.front().bas, max = iv.back().haut;
+    unsigned long long ecart = max - min;
+    unsigned long long nbValeurs = 0;             // exact seulement si ecart < CASE_MAX_TABLE
+    set<string> cibles;
+    for (auto& i : iv) {
+        nbValeurs += i.haut - i.bas + 1;
+        cibles.insert(i.cible);
+    }
+
+    // %rax -= min, puis un seul test non signé écarte les valeurs hors de [min, max]
+    auto Normalise = [&]() {
+        if (min != 0 && ImmediatCourt(min))
+            cout << "\tsubq $" << min << ", %rax" << endl;
+        else if (min != 0)
+            cout << "\tmovabsq $" << min << ", %rdx\n\tsubq %rdx, %rax" << endl;
+        cout << "\tcmpq $" << ecart << ", %rax" << endl;
+        cout << "\tja " << sinon << endl;
+    };
+
+    if (ecart < 64 && cibles.size() <= CASE_MAX_CIBLES_BITS && iv.size() > cibles.size()) {
+        // Tests de bits : un masque de 64 bits par branche
+        cout << "\t\t\t# CASE par tests de bits" << endl;
+        Normalise();
+        for (auto& c : cibles) {
+            unsigned long long masque = 0;
+            for (auto& i : iv)
+                if (i.cible == c)
+                    for (unsigned long long d = i.bas - min; d <= i.haut - min; d++)
+                        masque |= 1ULL << d;
+            cout << "\tmovq $" << masque << ", %rdx" << endl;
+            cout << "\tbtq %rax, %rdx" << endl;
+            cout << "\tjc " << c << endl;
+        }
+        cout << "\tjmp " << sinon << endl;
+    }
+    else if (iv.size() >= CASE_MIN_TABLE && ecart < CASE_MAX_TABLE
+             && nbValeurs * 100 >= (ecart + 1) * CASE_DENSITE_TABLE) {
+        // Table de sauts : accès direct en O(1)
+        cout << "\t\t\t# CASE par table de sauts" << endl;
+        Normalise();
+        cout << "\tjmp *TABLECASE" << tag << "(,%rax,8)" << endl;
+        cout << "\t.section .rodata" << endl;
+        cout << "\t.balign 8" << endl;
+        cout << "TABLECASE" << tag << ":" << endl;
+        size_t k = 0;
+        for (unsigned long long d = 0; d <= ecart; d++) {
+            unsigned long long v = min + d;
+            if (v > iv[k].haut) k++;
+            cout << "\t.quad " << (v >= iv[k].bas ? iv[k].cible : sinon) << endl;
+        }
+        cout << "\t.text" << endl;
+    }
+    else {
+        // Arbre de décision binaire : O(log n) comparaisons
+        cout << "\t\t\t# CASE par arbre de décision" << endl;
+        unsigned long noeud = 0;
+        ArbreCase(iv, 0, iv.size(), 0, ~0ULL, sinon, tag, noeud);
+    }
+
+    cout << fin << ":" << endl;
+}
+
+
 // Gère un bloc BEGIN ... END contenant plusieurs instructions
 // Syntaxe : BEGIN <instruction> { ; <instruction> } END
 void BlockStatement() {
@@ -704,17 +1455,17 @@ void BlockStatement() {
     current = (TOKEN) lexer->yylex();
 
     // Debug : afficher le token actuel et le texte associé
-    cout << "DEBUG BlockStatement : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
+    if (Traces) cerr << "DEBUG BlockStatement : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
 
     Statement();
 
     while (current == SEMICOLON) {
         current = (TOKEN) lexer->yylex();  // Passe le ";"
-        cout << "DEBUG après ';' : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
+        if (Traces) cerr << "DEBUG après ';' : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
         Statement();
     }
 
-    cout << "DEBUG avant END check : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
+    if (Traces) cerr << "DEBUG avant END check : current token = " << current << ", texte = '" << lexer->YYText() << "'" << endl;
 
     if (current != MOTCLE || GetKeyword() != END_)
         Erreur("'END' attendu pour fermer le bloc");
@@ -728,9 +1479,443 @@ void BlockStatement() {
 
 
 
+// Appel d'un sous-programme : nom déjà lu, current est le token suivant
+// Appel := ID ["(" [Expression {"," Expression}] ")"]
+// Retourne le type du résultat (une FUNCTION l'empile ; une PROCEDURE n'empile rien)
+TYPES AppelSousProgramme(const string& nom) {
+    SousProgramme& sp = SousProgrammes[nom];
+    vector<TYPES> types;
+    unsigned long empilees = ValeursEmpilees;
+
+    if (current == LPARENT) {
+        current = (TOKEN) lexer->yylex();
+        if (current != RPARENT) {
+            types.push_back(Expression());
+            while (current == COMMA) {
+                current = (TOKEN) lexer->yylex();
+                ValeursEmpilees = empilees + types.size();
+                types.push_back(Expression());
+            }
+            ValeursEmpilees = empilees;
+        }
+        if (current != RPARENT)
+            Erreur("')' attendue après les arguments de " + nom);
+        current = (TOKEN) lexer->yylex();
+    }
+
+    if (types.size() != sp.parametres.size())
+        Erreur("Nombre d'arguments incorrect pour " + nom);
+    for (size_t i = 0; i < types.size(); i++)
+        if (types[i] != sp.parametres[i].second)
+            TypeErreur("type incorrect pour le paramètre '" + sp.parametres[i].first + "' de " + nom);
+
+    // Les arguments sont sur la pile, le dernier au sommet
+    vector<size_t> enPile;                  // arguments au-delà des registres
+    for (size_t i = 0; i < types.size(); i++)
+        if (sp.registres[i].empty())
+            enPile.push_back(i);
+    if (enPile.empty()) {
+        for (size_t i = types.size(); i-- > 0; ) {
+            if (types[i] == DOUBLE_TYPE) {
+                cout << "\tmovsd (%rsp), " << sp.registres[i] << endl;
+                cout << "\taddq $8, %rsp" << endl;
+            }
+            else
+                cout << "\tpop " << sp.registres[i] << endl;
+        }
+        // System V : %rsp multiple de 16 au moment du call
+        if (ValeursEmpilees % 2)
+            cout << "\tsubq $8, %rsp\t# alignement de la pile" << endl;
+        cout << "\tcall " << EtiquetteSP(nom) << endl;
+        if (ValeursEmpilees % 2)
+            cout << "\taddq $8, %rsp" << endl;
+    }
+    else {
+        // Les arguments en pile sont recopiés sous les valeurs calculées, le
+        // premier au sommet, avec un mot de bourrage pour l'alignement ; les
+        // autres sont chargés dans leurs registres, puis tout est libéré au retour
+        size_t n = types.size(), k = enPile.size();
+        unsigned long reserve = 8 * (k + (ValeursEmpilees + n + k) % 2);
+        auto Argument = [&](size_t i) { return to_string(reserve + 8 * (n - 1 - i)) + "(%rsp)"; };
+        cout << "\tsubq $" << reserve << ", %rsp\t# arguments en pile" << endl;
+        for (size_t j = 0; j < k; j++) {
+            cout << "\tmovq " << Argument(enPile[j]) << ", %rax" << endl;
+            cout << "\tmovq %rax, " << 8 * j << "(%rsp)" << endl;
+        }
+        for (size_t i = 0; i < n; i++)
+            if (!sp.registres[i].empty())
+                cout << (types[i] == DOUBLE_TYPE ? "\tmovsd " : "\tmovq ") << Argument(i)
+                     << ", " << sp.registres[i] << endl;
+        cout << "\tcall " << EtiquetteSP(nom) << endl;
+        cout << "\taddq $" << reserve + 8 * n << ", %rsp" << endl;
+    }
+
+    if (!sp.fonction)
+        return UNSIGNED_INT;
+    if (sp.retour == DOUBLE_TYPE) {
+        cout << "\tsubq $8, %rsp" << endl;
+        cout << "\tmovsd %xmm0, (%rsp)\t# résultat double" << endl;
+    }
+    else
+        cout << "\tpush %rax\t# résultat de " << nom << endl;
+    return sp.retour;
+}
+
+
+// Découpe un texte assembleur en lignes
+vector<string> Lignes(const string& texte) {
+    vector<string> lignes;
+    istringstream in(texte);
+    string l;
+    while (getline(in, l))
+        lignes.push_back(l);
+    return lignes;
+}
+
+string Texte(const vector<string>& lignes) {
+    string texte;
+    for (auto& l : lignes)
+        texte += l + "\n";
+    return texte;
+}
+
+// Vrai si la ligne définit une étiquette ("NOM:")
+bool EstEtiquette(const string& l) {
+    return !l.empty() && l[0] != '\t' && l[0] != ' ' && l.back() == ':';
+}
+
+// Vrai si l'exécution passe de la ligne i au retour sans rien faire d'autre
+// (étiquettes, commentaires et sauts inconditionnels seulement)
+bool MeneAuRetour(const vector<string>& lignes, size_t i, const string& retour) {
+    for (unsigned pas = 0; i < lignes.size() && pas < 1000; pas++) {
+        const string& l = lignes[i];
+        size_t debut = l.find_first_not_of(" \t");
+        if (l == retour + ":")
+            return true;
+        if (EstEtiquette(l) || debut == string::npos || l[debut] == '#'
+            || l.compare(debut, 4, ".loc") == 0) {
+            i++;
+            continue;
+        }
+        if (l.compare(0, 5, "\tjmp ") == 0 && l[5] != '*') {
+            string cible = l.substr(5);
+            cible = cible.substr(0, cible.find_first_of(" \t"));
+            size_t j = 0;
+            while (j < lignes.size() && lignes[j] != cible + ":")
+                j++;
+            i = j;
+            continue;
+        }
+        return false;
+    }
+    return false;
+}
+
+// Élimination des appels terminaux : "f := g(...)" suivi du retour de f
+// devient un saut vers g après avoir libéré le cadre de f ; g retourne
+// directement à l'appelant de f. Un appel récursif terminal ne fait donc
+// plus grandir la pile.
+string AppelsTerminaux(const SousProgramme& sp, const string& code) {
+    if (!sp.fonction || sp.retour == DOUBLE_TYPE || sp.retour == CHAR_TYPE)
+        return code;
+    vector<string> lignes = Lignes(code);
+    for (size_t i = 0; i + 2 < lignes.size(); i++) {
+        if (lignes[i].compare(0, 6, "\tcall ") != 0)
+            continue;
+        string g = SousProgrammeCible(lignes[i].substr(6));
+        if (g.empty() || !SousProgrammes[g].fonction || SousProgrammes[g].retour != sp.retour)
+            continue;
+        if (lignes[i + 1].compare(0, 10, "\tpush %rax") != 0 || lignes[i + 2] != "\tpop -8(%rbp)")
+            continue;
+        if (!MeneAuRetour(lignes, i + 3, EtiquetteSP(sp.nom) + ".RETOUR"))
+            continue;
+        lignes[i] = "\tmovq %rbp, %rsp";
+        lignes[i + 1] = "\tpop %rbp";
+        lignes[i + 2] = "\tjmp " + EtiquetteSP(g) + "\t# appel terminal";
+    }
+    return Texte(lignes);
+}
+
+
+// Déclaration d'un sous-programme
+// SubprogramDeclaration := ("PROCEDURE" ID [Parametres] | "FUNCTION" ID [Parametres] ":" Type) ";"
+//                          [VarDeclarationPart] BlockStatement ";"
+// Parametres := "(" ID {"," ID} ":" Type {";" ID {"," ID} ":" Type} ")"
+// Dans une FUNCTION, le résultat est affecté au nom de la fonction.
+// Le code produit est conservé dans SousProgrammes : il n'est émis qu'à la fin,
+// s'il reste des appels après l'expansion en ligne.
+void SubprogramDeclaration() {
+    int ligne = lexer->lineno();
+    bool fonction = (GetKeyword() == FUNCTION_);
+    current = (TOKEN) lexer->yylex();
+
+    if (current != ID)
+        Erreur("Nom de sous-programme attendu");
+    string nom = lexer->YYText();
+    if (VariableConnue(nom) || SousProgrammes.count(nom))
+        Erreur("Nom déjà utilisé : " + nom);
+    current = (TOKEN) lexer->yylex();
+
+    SousProgramme& sp = SousProgrammes[nom];
+    sp.nom = nom;
+    sp.fonction = fonction;
+    sp.retour = UNSIGNED_INT;
+    sp.nbAppels = 0;
+    OrdreSousProgrammes.push_back(nom);
+
+    SPCourant = &sp;
+    VarsLocales.clear();
+    TailleCadre = fonction ? 8 : 0;     // -8(%rbp) : résultat de la fonction
+
+    if (current == LPARENT) {
+        current = (TOKEN) lexer->yylex();
+        unsigned nbEntiers = 0, nbFlottants = 0;
+        for (;;) {
+            vector<string> noms;
+            if (current != ID) Erreur("Nom de paramètre attendu");
+            noms.push_back(lexer->YYText());
+            current = (TOKEN) lexer->yylex();
+            while (current == COMMA) {
+                current = (TOKEN) lexer->yylex();
+                if (current != ID) Erreur("Nom de paramètre attendu après ','");
+                noms.push_back(lexer->YYText());
+                current = (TOKEN) lexer->yylex();
+            }
+            if (current != COLON) Erreur("':' attendu après les paramètres");
+            current = (TOKEN) lexer->yylex();
+            TYPES type = Type();
+
+            for (auto& p : noms) {
+                if (VarsLocales.count(p) || p == nom)
+                    Erreur("Paramètre déjà déclaré : " + p);
+                if (type == DOUBLE_TYPE)
+                    sp.registres.push_back(nbFlottants < NB_REGISTRES_FLOTTANTS
+                                           ? "%xmm" + to_string(nbFlottants++) : "");
+                else
+                    sp.registres.push_back(nbEntiers < NB_REGISTRES_ENTIERS
+                                           ? REGISTRES_ENTIERS[nbEntiers++] : "");
+                sp.parametres.push_back(make_pair(p, type));
+                TailleCadre += 8;
+                VarsLocales[p] = make_pair(type, -TailleCadre);
+            }
+
+            if (current != SEMICOLON) break;
+            current = (TOKEN) lexer->yylex();
+        }
+        if (current != RPARENT) Erreur("')' attendue après les paramètres");
+        current = (TOKEN) lexer->yylex();
+    }
+    int finParametres = TailleCadre;
+
+    if (fonction) {
+        if (current != COLON) Erreur("':' attendu avant le type de la fonction");
+        current = (TOKEN) lexer->yylex();
+        sp.retour = Type();
+        VarsLocales[nom] = make_pair(sp.retour, -8);
+    }
+
+    if (current != SEMICOLON) Erreur("';' attendu après l'en-tête de " + nom);
+    current = (TOKEN) lexer->yylex();
+
+    if (current == MOTCLE && GetKeyword() == VAR_)
+        VarDeclarationPart();
+
+    // Le corps est généré dans un tampon
+    ostringstream corps;
+    streambuf* sortie = cout.rdbuf(corps.rdbuf());
+    BlockStatement();
+    cout.rdbuf(sortie);
+
+    if (current != SEMICOLON) Erreur("';' attendu après la déclaration de " + nom);
+    current = (TOKEN) lexer->yylex();
+
+    // Prologue : cadre aligné sur 16 octets, paramètres sauvegardés, résultat et locales à zéro
+    ostringstream code;
+    int cadre = (TailleCadre + 15) / 16 * 16;
+    code << EtiquetteSP(nom) << ":" << endl;
+    code << Loc(ligne);
+    code << "\tpush %rbp" << endl;
+    code << "\tmovq %rsp, %rbp" << endl;
+    if (cadre)
+        code << "\tsubq $" << cadre << ", %rsp" << endl;
+    int pile = 16;                          // premier argument en pile, au-dessus de l'adresse de retour
+    for (size_t i = 0; i < sp.parametres.size(); i++) {
+        const string& p = sp.parametres[i].first;
+        if (sp.registres[i].empty()) {
+            code << "\tmovq " << pile << "(%rbp), %rax" << endl;
+            code << "\tmovq %rax, " << Adresse(p) << "\t# paramètre " << p << " (pile)" << endl;
+            pile += 8;
+        }
+        else
+            code << (sp.parametres[i].second == DOUBLE_TYPE ? "\tmovsd " : "\tmovq ")
+                 << sp.registres[i] << ", " << Adresse(p) << "\t# paramètre " << p << endl;
+    }
+    if (fonction)
+        code << "\tmovq $0, -8(%rbp)\t# résultat" << endl;
+    for (int d = finParametres + 8; d <= TailleCadre; d += 8)
+        code << "\tmovq $0, " << -d << "(%rbp)" << endl;
+    code << Compteur("APPEL_" + nom);
+
+    code << corps.str();
+
+    // Épilogue
+    code << EtiquetteSP(nom) << ".RETOUR:" << endl;
+    if (fonction) {
+        if (sp.retour == DOUBLE_TYPE)
+            code << "\tmovsd -8(%rbp), %xmm0" << endl;
+        else if (sp.retour == CHAR_TYPE)
+            code << "\tmovzbq -8(%rbp), %rax" << endl;
+        else
+            code << "\tmovq -8(%rbp), %rax" << endl;
+    }
+    code << "\tmovq %rbp, %rsp" << endl;
+    code << "\tpop %rbp" << endl;
+    code << "\tret" << endl;
+
+    sp.code = AppelsTerminaux(sp, code.str());
+
+    SPCourant = NULL;
+    VarsLocales.clear();
+    TailleCadre = 0;
+}
+
+
+// Nombre d'instructions d'un texte assembleur (ni étiquettes, ni directives, ni commentaires)
+unsigned NbInstructions(const vector<string>& lignes) {
+    unsigned n = 0;
+    for (auto& l : lignes) {
+        size_t debut = l.find_first_not_of(" \t");
+        if (!EstEtiquette(l) && debut != string::npos && l[debut] != '.' && l[debut] != '#')
+            n++;
+    }
+    return n;
+}
+
+// Renomme les étiquettes définies dans une copie de code (ajout d'un suffixe)
+vector<string> RenommeEtiquettes(const vector<string>& lignes, const string& suffixe) {
+    set<string> etiquettes;
+    for (auto& l : lignes) {
+        // "NOM:" seule ou suivie d'une instruction ("Vrai3:\tpush $-1")
+        size_t fin = l.find(':');
+        if (!l.empty() && l[0] != '\t' && l[0] != ' ' && fin != string::npos
+            && l.find_first_of(" \t") > fin)
+            etiquettes.insert(l.substr(0, fin));
+    }
+
+    vector<string> copie;
+    for (auto& l : lignes) {
+        string r;
+        size_t i = 0;
+        while (i < l.size()) {
+            if (isalpha((unsigned char)l[i]) || l[i] == '_') {
+                size_t j = i;            // un mot peut contenir des points (SP.f.RETOUR)
+                while (j < l.size() && (isalnum((unsigned char)l[j]) || l[j] == '_' || l[j] == '.'))
+                    j++;
+                string mot = l.substr(i, j - i);
+                r += etiquettes.count(mot) ? mot + suffixe : mot;
+                i = j;
+            }
+            else
+                r += l[i++];
+        }
+        copie.push_back(r);
+    }
+    return copie;
+}
+
+// Expansion en ligne des sous-programmes, dans l'ordre de déclaration
+// (un sous-programme ne peut appeler que ceux déclarés avant lui ou lui-même).
+// Un appel "call f" est remplacé par le code de f sans son étiquette ni son "ret" :
+// le cadre de pile est conservé, seuls l'appel et le retour disparaissent.
+// Le programme principal n'est parcouru que deux fois (comptage, puis
+// remplacement de tous les appels en une passe), quel que soit le nombre
+// de sous-programmes.
+void ExpansionEnLigne(string& principal) {
+    vector<string> lignesPrincipal = Lignes(principal);
+    map<string, unsigned long> appelsPrincipal;     // "\tcall f" ou "\tjmp f\t# appel terminal" -> nombre
+    for (auto& l : lignesPrincipal)
+        if (l.compare(0, 6, "\tcall ") == 0 || l.compare(0, 5, "\tjmp ") == 0)
+            appelsPrincipal[l]++;
+
+    map<string, vector<string>> modeles;            // "\tcall f" -> corps de f à recopier
+    for (size_t k = 0; k < OrdreSousProgrammes.size(); k++) {
+        SousProgramme& f = SousProgrammes[OrdreSousProgrammes[k]];
+        string appel = "\tcall " + EtiquetteSP(f.nom);
+        string saut = "\tjmp " + EtiquetteSP(f.nom) + "\t# appel terminal";
+
+        // Sous-programmes pouvant appeler f : ceux déclarés après lui
+        vector<string*> textes;
+        for (size_t j = k + 1; j < OrdreSousProgrammes.size(); j++)
+            textes.push_back(&SousProgrammes[OrdreSousProgrammes[j]].code);
+
+        unsigned long appels = appelsPrincipal[appel], sauts = appelsPrincipal[saut];
+        for (auto t : textes)
+            for (auto& l : Lignes(*t)) {
+                if (l == appel) appels++;
+                if (l == saut) sauts++;
+            }
+
+        vector<string> corps = Lignes(f.code);
+        bool recursif = f.code.find(appel + "\n") != string::npos || f.code.find(saut) != string::npos;
+        bool terminal = f.code.find("# appel terminal") != string::npos;
+        // Avec un profil : seuil relevé pour un sous-programme souvent appelé,
+        // pas de copie d'un sous-programme jamais appelé (sauf site unique)
+        unsigned long long frequence;
+        unsigned seuil = SEUIL_EN_LIGNE;
+        if (Frequence("APPEL_" + f.nom, frequence))
+            seuil = frequence >= SEUIL_CHAUD ? SEUIL_EN_LIGNE_CHAUD : frequence == 0 ? 0 : SEUIL_EN_LIGNE;
+        bool enLigne = ExpansionEnLigneActive && appels > 0 && !recursif && !terminal
+                       && (appels + sauts == 1 || NbInstructions(corps) <= seuil);
+
+        if (enLigne) {
+            // Sans son étiquette d'entrée ni son "ret" ; la place de l'adresse de
+            // retour est gardée pour que le cadre (push %rbp) reste aligné sur 16 octets
+            vector<string>& modele = modeles[appel];
+            modele.assign(corps.begin() + 1, corps.end() - 1);
+            modele.insert(modele.begin(), "\tsubq $8, %rsp\t# place de l'adresse de retour");
+            modele.push_back("\taddq $8, %rsp");
+            for (auto t : textes) {
+                vector<string> lignes = Lignes(*t), resultat;
+                for (auto& l : lignes) {
+                    if (l != appel) {
+                        resultat.push_back(l);
+                        continue;
+                    }
+                    resultat.push_back("\t\t\t# " + f.nom + " en ligne");
+                    for (auto& c : RenommeEtiquettes(modele, "_L" + to_string(++tagID)))
+                        resultat.push_back(c);
+                }
+                *t = Texte(resultat);
+            }
+            appels = 0;
+        }
+        f.nbAppels = appels + sauts;
+    }
+
+    if (modeles.empty())
+        return;
+    string resultat;
+    resultat.reserve(principal.size());
+    for (auto& l : lignesPrincipal) {
+        auto m = modeles.find(l);
+        if (m == modeles.end()) {
+            resultat += l;
+            resultat += '\n';
+            continue;
+        }
+        resultat += "\t\t\t# " + l.substr(6) + " en ligne\n";
+        for (auto& c : RenommeEtiquettes(m->second, "_L" + to_string(++tagID))) {
+            resultat += c;
+            resultat += '\n';
+        }
+    }
+    principal.swap(resultat);
+}
+
+
 // Partie exécutable du programme : enchaînement d’instructions terminées par un point
 void StatementPart(void) {
-    cout << "\t.text\n\t.globl main\nmain:\n\tmovq %rsp, %rbp" << endl;
+    cout << "\t.text\n\t.globl main\nmain:\n" << Loc(lexer->lineno()) << "\tpush %rbp\t\t\t# pile alignée sur 16 octets entre les instructions\n\tmovq %rsp, %rbp" << endl;
 
     Statement();
 
@@ -745,11 +1930,14 @@ void StatementPart(void) {
     current = (TOKEN) lexer->yylex();
 }
 
-// Lance l'analyse complète : déclaration + instructions
+// Lance l'analyse complète : déclarations + sous-programmes + instructions
+// Program := [VarDeclarationPart] {SubprogramDeclaration} StatementPart
 void Program() {
     if (current == MOTCLE && GetKeyword() == VAR_) {
         VarDeclarationPart();  // On traite la section VAR avant les instructions
     }
+    while (current == MOTCLE && (GetKeyword() == PROCEDURE_ || GetKeyword() == FUNCTION_))
+        SubprogramDeclaration();
     StatementPart();
 }
 
@@ -778,7 +1966,7 @@ void DisplayStatement() {
         cout << "\tcall puts@PLT" << endl;
     } else if (t == DOUBLE_TYPE) {
         cout << "\tmovsd (%rsp), %xmm0\t# récupère le double" << endl;
-        cout << "\tsubq $8, %rsp\t\t# dépile la pile générale" << endl;
+        cout << "\taddq $8, %rsp\t\t# dépile la pile générale" << endl;
         cout << "\tmovq $FormatString2, %rdi\t# \"%f\\n\"" << endl;
         cout << "\tmovl $1, %eax" << endl; 
         cout << "\tcall printf@PLT" << endl;
@@ -793,58 +1981,1100 @@ void DisplayStatement() {
 }
 
 
+// === Propagation des constantes et élimination du code mort ===
+// Passe sur le texte du programme principal, après l'expansion en ligne.
+// Le texte est découpé en blocs de base (une étiquette commence un bloc, un
+// saut le termine). Le code à pile n'a pas de registres virtuels : les valeurs
+// suivies sont les variables globales de 8 octets. Plutôt que de construire
+// la forme SSA (une version par affectation, des phi aux jonctions, puis des
+// copies pour en sortir), chaque bloc garde la valeur de chaque variable à son
+// entrée, réunie sur les seules arêtes exécutables : c'est la propagation
+// conditionnelle des constantes de Wegman et Zadeck, et comme les variables
+// restent en mémoire, il n'y a aucune copie à ajouter en sortie.
+// 1. propagation : une lecture d'une variable constante devient une valeur
+//    immédiate, un saut conditionnel décidé devient un jmp ou disparaît, une
+//    affectation d'une expression constante devient un seul movq, et les
+//    blocs jamais atteints sont supprimés ;
+// 2. écritures mortes : une variable écrite puis jamais relue (vivacité sur
+//    le graphe) n'est plus écrite ; son calcul disparaît s'il est pur ;
+// 3. les variables qui ne sont plus référencées ne sont pas placées dans .bss.
+
+// Valeur d'une variable ou d'un registre : pas encore atteinte, constante
+// connue ou quelconque
+struct Valeur {
+    enum { INDEFINIE, CONSTANTE, VARIABLE } etat;
+    unsigned long long c;
+};
+const Valeur INCONNUE = {Valeur::VARIABLE, 0};
+
+Valeur Constante(unsigned long long c) { return {Valeur::CONSTANTE, c}; }
+
+bool operator==(const Valeur& a, const Valeur& b) {
+    return a.etat == b.etat && (a.etat != Valeur::CONSTANTE || a.c == b.c);
+}
+
+// Réunion des valeurs arrivant par deux chemins
+Valeur Reunion(const Valeur& a, const Valeur& b) {
+    if (a.etat == Valeur::INDEFINIE) return b;
+    if (b.etat == Valeur::INDEFINIE) return a;
+    return a == b ? a : INCONNUE;
+}
+
+// Instruction décodée : mnémonique vide pour une étiquette, une directive ou un commentaire
+struct InstructionAsm {
+    string mnemonique;
+    vector<string> operandes;
+};
+
+InstructionAsm Decode(const string& l) {
+    InstructionAsm ins;
+    size_t debut = l.find_first_not_of(" \t");
+    if (l.empty() || l[0] != '\t' || debut == string::npos || l[debut] == '.' || l[debut] == '#')
+        return ins;
+    size_t fin = l.find_first_of(" \t", debut);
+    ins.mnemonique = l.substr(debut, fin - debut);
+    if (fin == string::npos)
+        return ins;
+    string operande;
+    int parentheses = 0;
+    for (size_t k = fin; k < l.size() && l[k] != '#'; k++) {
+        char c = l[k];
+        if (c == '(') parentheses++;
+        if (c == ')') parentheses--;
+        if (c == ',' && parentheses == 0) {
+            ins.operandes.push_back(operande);
+            operande.clear();
+        }
+        else if (c != ' ' && c != '\t')
+            operande += c;
+    }
+    if (!operande.empty())
+        ins.operandes.push_back(operande);
+    return ins;
+}
+
+// Nom de la variable globale désignée par un opérande ("x(%rip)" ou "x"), "" sinon
+string NomGlobal(const string& operande) {
+    string nom = operande;
+    if (nom.size() > 6 && nom.compare(nom.size() - 6, 6, "(%rip)") == 0)
+        nom.erase(nom.size() - 6);
+    return DeclaredVars.count(nom) ? nom : "";
+}
+
+const char* REGISTRES_SUIVIS[] = {"%rax", "%rbx", "%rcx", "%rdx", "%rsi", "%rdi"};
+const int NB_REGISTRES_SUIVIS = 6;
+
+int IndexRegistre(const string& operande) {
+    for (int r = 0; r < NB_REGISTRES_SUIVIS; r++)
+        if (operande == REGISTRES_SUIVIS[r])
+            return r;
+    return -1;
+}
+
+// État abstrait de la machine pendant la simulation d'un bloc
+struct EtatMachine {
+    vector<Valeur> vars;                // variables suivies (indices de VarsSuivies)
+    Valeur regs[NB_REGISTRES_SUIVIS];
+    Valeur al;                          // octet écrit par setcc
+    Valeur gauche, droite;              // dernière comparaison "cmpq droite, gauche"
+    vector<Valeur> pile;                // sommet de pile connu (vide : inconnu)
+};
+
+map<string, int> VarsSuivies;           // variable de 8 octets -> indice dans EtatMachine::vars
+
+int IndexVariable(const string& operande) {
+    string nom = NomGlobal(operande);
+    auto v = VarsSuivies.find(nom);
+    return nom.empty() || v == VarsSuivies.end() ? -1 : v->second;
+}
+
+Valeur ValeurOperande(const EtatMachine& e, const string& operande) {
+    if (operande[0] == '$') {
+        bool negatif = operande.size() > 1 && operande[1] == '-';
+        string chiffres = operande.substr(negatif ? 2 : 1);
+        if (chiffres.empty() || chiffres.find_first_not_of("0123456789") != string::npos)
+            return INCONNUE;            // adresse d'une étiquette
+        unsigned long long n = strtoull(chiffres.c_str(), NULL, 10);
+        return Constante(negatif ? -n : n);
+    }
+    int r = IndexRegistre(operande);
+    if (r >= 0)
+        return e.regs[r];
+    int v = IndexVariable(operande);
+    return v >= 0 ? e.vars[v] : INCONNUE;
+}
+
+void Ecrit(EtatMachine& e, const string& operande, Valeur valeur) {
+    int r = IndexRegistre(operande);
+    int v = IndexVariable(operande);
+    if (r >= 0)
+        e.regs[r] = valeur;
+    else if (v >= 0)
+        e.vars[v] = valeur;
+    else if (operande.find("%rsp") != string::npos)
+        e.pile.clear();                     // %rsp ou un mot de la pile (N(%rsp))
+}
+
+Valeur Depile(EtatMachine& e) {
+    if (e.pile.empty())
+        return INCONNUE;
+    Valeur v = e.pile.back();
+    e.pile.pop_back();
+    return v;
+}
+
+// Résultat de la condition cc ("e", "ne", "b"...) après la dernière
+// comparaison : 1 vraie, 0 fausse, -1 inconnue
+int Condition(const EtatMachine& e, const string& cc) {
+    if (e.gauche.etat != Valeur::CONSTANTE || e.droite.etat != Valeur::CONSTANTE)
+        return -1;
+    unsigned long long g = e.gauche.c, d = e.droite.c;
+    if (cc == "e")  return g == d;
+    if (cc == "ne") return g != d;
+    if (cc == "b")  return g < d;
+    if (cc == "a")  return g > d;
+    if (cc == "be") return g <= d;
+    if (cc == "ae") return g >= d;
+    return -1;
+}
+
+void OublieRegistres(EtatMachine& e) {
+    for (auto& r : e.regs)
+        r = INCONNUE;
+    e.al = e.gauche = e.droite = INCONNUE;
+}
+
+bool EstSaut(const InstructionAsm& ins) {
+    return !ins.mnemonique.empty() && ins.mnemonique[0] == 'j';
+}
+
+bool AppelSousProgrammeAsm(const InstructionAsm& ins) {
+    return ins.mnemonique == "call" && !ins.operandes.empty() && !SousProgrammeCible(ins.operandes[0]).empty();
+}
+
+// Effet d'une instruction (sauf les sauts) sur l'état abstrait
+void Execute(EtatMachine& e, const InstructionAsm& ins) {
+    const string& m = ins.mnemonique;
+    const vector<string>& o = ins.operandes;
+    bool arithmetique = m == "addq" || m == "subq";
+    if (m == "push" && o.size() == 1)
+        e.pile.push_back(ValeurOperande(e, o[0]));
+    else if (m == "pop" && o.size() == 1)
+        Ecrit(e, o[0], Depile(e));
+    else if ((m == "movq" || m == "movabsq") && o.size() == 2)
+        Ecrit(e, o[1], ValeurOperande(e, o[0]));
+    else if (arithmetique && o.size() == 2 && o[1] == "%rsp" && o[0][0] == '$') {
+        long n = atol(o[0].c_str() + 1) / 8;
+        for (long k = 0; k < n; k++)
+            if (m == "addq") Depile(e); else e.pile.push_back(INCONNUE);
+        e.gauche = e.droite = INCONNUE;
+    }
+    else if (arithmetique && o.size() == 2) {
+        Valeur a = ValeurOperande(e, o[1]), b = ValeurOperande(e, o[0]);
+        bool constantes = a.etat == Valeur::CONSTANTE && b.etat == Valeur::CONSTANTE;
+        Ecrit(e, o[1], !constantes ? INCONNUE : Constante(m == "addq" ? a.c + b.c : a.c - b.c));
+        e.gauche = e.droite = INCONNUE;
+    }
+    else if (m == "mulq" && o.size() == 1) {
+        Valeur a = e.regs[0], b = ValeurOperande(e, o[0]);
+        bool constantes = a.etat == Valeur::CONSTANTE && b.etat == Valeur::CONSTANTE;
+        e.regs[0] = constantes ? Constante(a.c * b.c) : INCONNUE;
+        e.regs[3] = INCONNUE;
+        e.gauche = e.droite = INCONNUE;
+    }
+    else if (m == "div" && o.size() == 1) {
+        Valeur a = e.regs[0], b = ValeurOperande(e, o[0]);
+        if (a.etat == Valeur::CONSTANTE && b.etat == Valeur::CONSTANTE && b.c != 0
+            && e.regs[3] == Constante(0)) {
+            e.regs[0] = Constante(a.c / b.c);
+            e.regs[3] = Constante(a.c % b.c);
+        }
+        else
+            e.regs[0] = e.regs[3] = INCONNUE;
+        e.gauche = e.droite = INCONNUE;
+    }
+    else if ((m == "negq" || m == "notq" || m == "incq") && o.size() == 1) {
+        Valeur a = ValeurOperande(e, o[0]);
+        if (a.etat == Valeur::CONSTANTE)
+            a.c = m == "negq" ? -a.c : m == "notq" ? ~a.c : a.c + 1;
+        Ecrit(e, o[0], a);
+        e.gauche = e.droite = INCONNUE;
+    }
+    else if (m == "cmpq" && o.size() == 2) {
+        e.gauche = ValeurOperande(e, o[1]);
+        e.droite = ValeurOperande(e, o[0]);
+    }
+    else if (m.compare(0, 3, "set") == 0 && o.size() == 1 && o[0] == "%al") {
+        int c = Condition(e, m.substr(3));
+        e.al = c < 0 ? INCONNUE : Constante(c);
+        e.regs[0] = INCONNUE;
+    }
+    else if (m == "movzbq" && o.size() == 2 && o[0] == "%al" && o[1] == "%rax")
+        e.regs[0] = e.al;
+    else if (m.compare(0, 4, "cmov") == 0 && o.size() == 2) {
+        int c = Condition(e, m.substr(4));
+        Valeur source = ValeurOperande(e, o[0]), destination = ValeurOperande(e, o[1]);
+        Ecrit(e, o[1], c == 1 ? source : c == 0 ? destination : Reunion(source, destination));
+    }
+    else if (m == "call") {
+        OublieRegistres(e);
+        if (AppelSousProgrammeAsm(ins))         // un sous-programme peut écrire les globales
+            for (auto& v : e.vars)
+                v = INCONNUE;
+    }
+    else if (!EstSaut(ins) && m != "ret") {
+        // Autre instruction : registres et drapeaux perdus, opérandes peut-être écrits
+        OublieRegistres(e);
+        for (auto& operande : o) {
+            if (operande.find("%rsp") != string::npos)
+                e.pile.clear();
+            int v = IndexVariable(operande);
+            if (v >= 0)
+                e.vars[v] = INCONNUE;
+        }
+    }
+}
+
+// Variation de la pile causée par une instruction (en mots de 8 octets)
+int EffetPile(const InstructionAsm& ins) {
+    if (ins.mnemonique == "push") return 1;
+    if (ins.mnemonique == "pop") return -1;
+    if ((ins.mnemonique == "addq" || ins.mnemonique == "subq") && ins.operandes.size() == 2
+        && ins.operandes[1] == "%rsp" && ins.operandes[0][0] == '$') {
+        int n = atoi(ins.operandes[0].c_str() + 1) / 8;
+        return ins.mnemonique == "addq" ? -n : n;
+    }
+    return 0;
+}
+
+// Début du calcul de la valeur écrite par la ligne i ("pop X", ou "movq %reg, X"
+// avec reste = 0) : la ligne .loc de l'instruction, dans le même bloc, si tout le
+// code entre les deux est pur et laisse exactement reste valeurs sur la pile ; -1 sinon
+long DebutCalcul(const vector<string>& lignes, size_t debut, size_t i, int reste = 1) {
+    size_t m = i;
+    while (m > debut && lignes[m].compare(0, 5, "\t.loc") != 0)
+        m--;
+    if (lignes[m].compare(0, 5, "\t.loc") != 0)
+        return -1;
+    int profondeur = 0;
+    for (size_t k = m + 1; k < i; k++) {
+        InstructionAsm ins = Decode(lignes[k]);
+        if (ins.mnemonique.empty())
+            continue;
+        if (!InstructionPure(lignes[k]))
+            return -1;
+        profondeur += EffetPile(ins);
+        if (profondeur < 0)
+            return -1;
+    }
+    return profondeur == reste ? m : -1;
+}
+
+// Écriture d'une constante dans un registre ou une variable
+string EcritureConstante(unsigned long long c, const string& destination) {
+    long long n = c;
+    if (n >= INT_MIN && n <= INT_MAX)
+        return "\tmovq $" + to_string(n) + ", " + destination;
+    if (destination[0] == '%')
+        return "\tmovabsq $" + to_string(c) + ", " + destination;
+    return "\tmovabsq $" + to_string(c) + ", %rax\n\tmovq %rax, " + destination;
+}
+
+// Graphe des blocs de base d'un texte assembleur
+struct BlocAsm {
+    size_t debut, fin;                  // lignes [debut, fin)
+    long saut = -1;                     // bloc cible du saut final (-1 : aucun)
+    bool conditionnel = false;          // le saut peut ne pas être pris
+    bool suite = true;                  // l'exécution peut continuer au bloc suivant
+    bool sortieInconnue = false;        // saut hors du texte (ou table inconnue), ou ret
+    vector<size_t> table;               // jmp *TABLE(,%rax,8) : blocs cibles de la table
+    string instructionSaut;             // mnémonique du saut final
+};
+
+vector<BlocAsm> Blocs(const vector<string>& lignes, const vector<InstructionAsm>& code,
+                      map<string, size_t>& etiquettes) {
+    vector<BlocAsm> blocs;
+    etiquettes.clear();
+    bool nouveau = true;                // la ligne commence un bloc
+    for (size_t i = 0; i < lignes.size(); i++) {
+        bool etiquette = EstEtiquette(lignes[i]);
+        if (nouveau || etiquette) {
+            BlocAsm b;
+            b.debut = i;
+            blocs.push_back(b);
+            if (etiquette)
+                etiquettes[lignes[i].substr(0, lignes[i].size() - 1)] = blocs.size() - 1;
+            nouveau = false;
+        }
+        blocs.back().fin = i + 1;
+        const InstructionAsm& ins = code[i];
+        if (EstSaut(ins) || ins.mnemonique == "ret") {
+            blocs.back().instructionSaut = ins.mnemonique;
+            nouveau = true;
+        }
+    }
+
+    // Tables de sauts des CASE : "TABLE:" suivie de lignes ".quad CIBLE"
+    map<string, vector<size_t>> tables;
+    for (size_t i = 0; i + 1 < lignes.size(); i++)
+        if (EstEtiquette(lignes[i]) && lignes[i + 1].compare(0, 7, "\t.quad ") == 0) {
+            vector<size_t>& cibles = tables[lignes[i].substr(0, lignes[i].size() - 1)];
+            for (size_t k = i + 1; k < lignes.size() && lignes[k].compare(0, 7, "\t.quad ") == 0; k++)
+                if (etiquettes.count(lignes[k].substr(7)))
+                    cibles.push_back(etiquettes[lignes[k].substr(7)]);
+        }
+
+    for (size_t b = 0; b < blocs.size(); b++) {
+        BlocAsm& bloc = blocs[b];
+        const string& m = bloc.instructionSaut;
+        bloc.suite = m.empty() || (m != "jmp" && m != "ret");
+        bloc.conditionnel = !m.empty() && m != "jmp" && m != "ret";
+        if (b + 1 == blocs.size())
+            bloc.suite = false;
+        if (m.empty())
+            continue;
+        const InstructionAsm& ins = code[bloc.fin - 1];
+        string table = ins.operandes.empty() || ins.operandes[0][0] != '*' ? ""
+                     : ins.operandes[0].substr(1, ins.operandes[0].find('(') - 1);
+        if (tables.count(table))
+            bloc.table = tables[table];
+        else if (m == "ret" || ins.operandes.empty() || !etiquettes.count(ins.operandes[0]))
+            bloc.sortieInconnue = true;
+        else
+            bloc.saut = etiquettes[ins.operandes[0]];
+    }
+    return blocs;
+}
+
+// Vrai si tous les chemins du texte sont connus : aucun saut hors du texte ni
+// vers une table inconnue, aucune adresse d'étiquette prise ("$ETIQUETTE")
+bool GrapheComplet(const vector<BlocAsm>& blocs, const vector<InstructionAsm>& code,
+                   const map<string, size_t>& etiquettes) {
+    for (auto& b : blocs)
+        if (b.sortieInconnue && b.instructionSaut != "ret")
+            return false;
+    for (auto& ins : code)
+        for (auto& o : ins.operandes)
+            if (o[0] == '$' && etiquettes.count(o.substr(1)))
+                return false;
+    return true;
+}
+
+const unsigned long long PROPAGATION_TAILLE_MAX = 1 << 22;  // blocs x variables au-delà desquels la passe est sautée
+const unsigned long long PROPAGATION_LIGNES_MAX = 1 << 19;  // lignes du texte au-delà desquelles elle est sautée
+const unsigned long long PROPAGATION_BLOC_MAX = 1 << 14;    // lignes d'un seul bloc au-delà desquelles elle est sautée
+
+// 1. Propagation conditionnelle des constantes ; renvoie faux si le texte est trop grand
+bool PropagationConstantes(vector<string>& lignes) {
+    vector<InstructionAsm> code;
+    code.reserve(lignes.size());
+    for (auto& l : lignes)
+        code.push_back(Decode(l));
+    map<string, size_t> etiquettes;
+    vector<BlocAsm> blocs = Blocs(lignes, code, etiquettes);
+    size_t nv = VarsSuivies.size();
+    if ((unsigned long long) blocs.size() * (nv + 1) > PROPAGATION_TAILLE_MAX
+        || !GrapheComplet(blocs, code, etiquettes))
+        return false;
+
+    vector<vector<Valeur>> entree(blocs.size(), vector<Valeur>(nv, Valeur{Valeur::INDEFINIE, 0}));
+    vector<bool> executable(blocs.size(), false), enAttente(blocs.size(), false);
+    vector<size_t> travail;
+    auto Atteint = [&](size_t b, const vector<Valeur>& vars) {
+        bool change = !executable[b];
+        executable[b] = true;
+        for (size_t v = 0; v < nv; v++) {
+            Valeur r = Reunion(entree[b][v], vars[v]);
+            if (!(r == entree[b][v])) {
+                entree[b][v] = r;
+                change = true;
+            }
+        }
+        if (change && !enAttente[b]) {
+            enAttente[b] = true;
+            travail.push_back(b);
+        }
+    };
+    if (!blocs.empty())
+        Atteint(0, vector<Valeur>(nv, Constante(0)));        // .bss est initialisé à zéro
+
+    // Simule un bloc depuis son état d'entrée ; decision reçoit la décision du saut final
+    auto Simule = [&](size_t b, EtatMachine& e, int& decision) {
+        e.vars = entree[b];
+        OublieRegistres(e);
+        e.pile.clear();
+        decision = -1;
+        for (size_t i = blocs[b].debut; i < blocs[b].fin; i++) {
+            const InstructionAsm& ins = code[i];
+            if (ins.mnemonique.empty())
+                continue;
+            if (EstSaut(ins) && ins.mnemonique != "jmp")
+                decision = Condition(e, ins.mnemonique.substr(1));
+            Execute(e, ins);
+        }
+    };
+
+    while (!travail.empty()) {
+        size_t b = travail.back();
+        travail.pop_back();
+        enAttente[b] = false;
+        EtatMachine e;
+        int decision;
+        Simule(b, e, decision);
+        const BlocAsm& bloc = blocs[b];
+        if (bloc.saut >= 0 && (!bloc.conditionnel || decision != 0))
+            Atteint(bloc.saut, e.vars);
+        if (bloc.suite && (!bloc.conditionnel || decision != 1))
+            Atteint(b + 1, e.vars);
+        for (size_t s : bloc.table)
+            Atteint(s, e.vars);
+    }
+
+    // Réécriture avec les valeurs trouvées
+    vector<bool> supprimee(lignes.size(), false);
+    for (size_t b = 0; b < blocs.size(); b++) {
+        if (!executable[b]) {
+            for (size_t i = blocs[b].debut; i < blocs[b].fin; i++)
+                if (!code[i].mnemonique.empty())
+                    supprimee[i] = true;         // code inaccessible
+            continue;
+        }
+        EtatMachine e;
+        e.vars = entree[b];
+        OublieRegistres(e);
+        for (size_t i = blocs[b].debut; i < blocs[b].fin; i++) {
+            const InstructionAsm& ins = code[i];
+            if (ins.mnemonique.empty())
+                continue;
+            const vector<string>& o = ins.operandes;
+            if (EstSaut(ins) && ins.mnemonique != "jmp") {
+                int c = Condition(e, ins.mnemonique.substr(1));
+                if (c == 1)
+                    lignes[i] = "\tjmp " + o[0] + "\t# condition toujours vraie";
+                else if (c == 0)
+                    supprimee[i] = true;
+                // Le calcul de la condition ("... pop %rax ; cmpq $0, %rax") ne sert plus
+                long m = c >= 0 && i >= blocs[b].debut + 2 && lignes[i - 1] == "\tcmpq $0, %rax"
+                         && lignes[i - 2] == "\tpop %rax" ? DebutCalcul(lignes, blocs[b].debut, i - 2) : -1;
+                for (long k = m + 1; m >= 0 && k < (long) i; k++)
+                    supprimee[k] = supprimee[k] || !Decode(lignes[k]).mnemonique.empty();
+            }
+            else if (ins.mnemonique == "movq" && o.size() == 2 && IndexRegistre(o[1]) >= 0
+                     && IndexVariable(o[0]) >= 0 && e.vars[IndexVariable(o[0])].etat == Valeur::CONSTANTE)
+                lignes[i] = EcritureConstante(e.vars[IndexVariable(o[0])].c, o[1]) + "\t# " + NomGlobal(o[0]);
+            else if (ins.mnemonique == "pop" && o.size() == 1 && IndexVariable(o[0]) >= 0
+                     && !e.pile.empty() && e.pile.back().etat == Valeur::CONSTANTE) {
+                // Affectation d'une expression constante : un seul movq
+                long m = DebutCalcul(lignes, blocs[b].debut, i);
+                if (m >= 0) {
+                    for (size_t k = m + 1; k < i; k++)
+                        if (!Decode(lignes[k]).mnemonique.empty())
+                            supprimee[k] = true;
+                    lignes[i] = EcritureConstante(e.pile.back().c, o[0]);
+                }
+            }
+            else if (ins.mnemonique == "movq" && o.size() == 2 && IndexRegistre(o[0]) >= 0
+                     && IndexVariable(o[1]) >= 0 && e.regs[IndexRegistre(o[0])].etat == Valeur::CONSTANTE
+                     && i + 1 < lignes.size() && Decode(lignes[i + 1]).mnemonique.empty()) {
+                // IF converti en cmov dont la condition est connue ; la ligne
+                // suivante doit finir l'instruction (sinon une autre écriture suit)
+                long m = DebutCalcul(lignes, blocs[b].debut, i, 0);
+                if (m >= 0) {
+                    for (size_t k = m + 1; k < i; k++)
+                        if (!Decode(lignes[k]).mnemonique.empty())
+                            supprimee[k] = true;
+                    lignes[i] = EcritureConstante(e.regs[IndexRegistre(o[0])].c, o[1]);
+                }
+            }
+            Execute(e, ins);
+        }
+    }
+
+    vector<string> resultat;
+    for (size_t i = 0; i < lignes.size(); i++)
+        if (!supprimee[i])
+            resultat.push_back(lignes[i]);
+    lignes = Lignes(Texte(resultat));   // une constante de 64 bits a pu ajouter une ligne
+
+    // Un jmp vers une étiquette qui le suit (branche supprimée) ne sert à rien :
+    // entre les deux, seulement des étiquettes, des .loc ou des commentaires
+    resultat.clear();
+    for (size_t i = 0; i < lignes.size(); i++) {
+        InstructionAsm ins = Decode(lignes[i]);
+        bool inutile = false;
+        for (size_t k = i + 1; ins.mnemonique == "jmp" && ins.operandes.size() == 1 && k < lignes.size(); k++) {
+            const string& l = lignes[k];
+            size_t debut = l.find_first_not_of(" \t");
+            if (l == ins.operandes[0] + ":")
+                inutile = true;
+            if (inutile || !(EstEtiquette(l) || l.compare(0, 5, "\t.loc") == 0
+                             || (debut != string::npos && l[debut] == '#')))
+                break;
+        }
+        if (!inutile)
+            resultat.push_back(lignes[i]);
+    }
+    lignes = resultat;
+    return true;
+}
+
+// 2. Écritures mortes ; renvoie vrai si le texte a changé
+bool EcrituresMortes(vector<string>& lignes) {
+    vector<InstructionAsm> code;
+    code.reserve(lignes.size());
+    for (auto& l : lignes)
+        code.push_back(Decode(l));
+    map<string, size_t> etiquettes;
+    vector<BlocAsm> blocs = Blocs(lignes, code, etiquettes);
+    map<string, size_t> indices;                // toutes les globales, CHAR compris
+    for (auto& v : DeclaredVars) {
+        size_t n = indices.size();
+        indices[v.first] = n;
+    }
+    size_t nv = indices.size();
+
+    // Effet de chaque ligne sur les variables vivantes, calculé une fois :
+    // variables lues, variable écrite, fin du programme (ret) ou appel
+    struct EffetVivacite {
+        vector<size_t> lues;
+        long ecrite = -1;
+        bool fin = false, appel = false;
+    };
+    vector<EffetVivacite> effets(lignes.size());
+    for (size_t i = 0; i < lignes.size(); i++) {
+        const string& m = code[i].mnemonique;
+        const vector<string>& o = code[i].operandes;
+        EffetVivacite& f = effets[i];
+        f.fin = m == "ret";
+        f.appel = AppelSousProgrammeAsm(code[i]);
+        for (size_t k = 0; k < o.size(); k++) {
+            string nom = NomGlobal(o[k]);
+            if (nom.empty())
+                continue;
+            if ((m == "pop" && k == 0) || (m == "movq" && k == 1))
+                f.ecrite = indices[nom];
+            else
+                f.lues.push_back(indices[nom]);
+        }
+    }
+    // Ensembles de variables vivantes : un bit par variable, par mots de 64 bits
+    size_t nm = (nv + 63) / 64;
+    typedef vector<unsigned long long> Ensemble;
+    auto Vivante = [](const Ensemble& e, size_t v) { return (e[v / 64] >> (v % 64)) & 1; };
+    auto Transfert = [&](const EffetVivacite& f, Ensemble& vivantes) {
+        if (f.fin)
+            vivantes.assign(nm, 0);             // fin du programme principal
+        else if (f.appel)
+            vivantes.assign(nm, ~0ULL);         // un sous-programme peut lire les globales
+        else {
+            if (f.ecrite >= 0)
+                vivantes[f.ecrite / 64] &= ~(1ULL << (f.ecrite % 64));
+            for (size_t v : f.lues)
+                vivantes[v / 64] |= 1ULL << (v % 64);
+        }
+    };
+
+    vector<Ensemble> entree(blocs.size(), Ensemble(nm, 0));
+    auto Sortie = [&](size_t b) {
+        const BlocAsm& bloc = blocs[b];
+        Ensemble vivantes(nm, bloc.sortieInconnue && bloc.instructionSaut != "ret" ? ~0ULL : 0);
+        auto Ajoute = [&](const Ensemble& e) {
+            for (size_t k = 0; k < nm; k++)
+                vivantes[k] |= e[k];
+        };
+        for (size_t s : bloc.table)
+            Ajoute(entree[s]);
+        if (bloc.saut >= 0)
+            Ajoute(entree[bloc.saut]);
+        if (bloc.suite)
+            Ajoute(entree[b + 1]);
+        return vivantes;
+    };
+    // Liste de travail : un bloc est recalculé quand l'entrée d'un successeur change
+    vector<vector<size_t>> predecesseurs(blocs.size());
+    for (size_t b = 0; b < blocs.size(); b++) {
+        if (blocs[b].saut >= 0)
+            predecesseurs[blocs[b].saut].push_back(b);
+        if (blocs[b].suite)
+            predecesseurs[b + 1].push_back(b);
+        for (size_t s : blocs[b].table)
+            predecesseurs[s].push_back(b);
+    }
+    // Toujours le bloc en attente le plus loin dans le texte : l'information
+    // remonte le code dans l'ordre, sans repasser inutilement par les boucles
+    set<size_t> travail;
+    for (size_t b = 0; b < blocs.size(); b++)
+        travail.insert(b);
+    while (!travail.empty()) {
+        size_t b = *travail.rbegin();
+        travail.erase(b);
+        Ensemble vivantes = Sortie(b);
+        for (size_t i = blocs[b].fin; i-- > blocs[b].debut; )
+            Transfert(effets[i], vivantes);
+        if (vivantes != entree[b]) {
+            entree[b] = vivantes;
+            for (size_t p : predecesseurs[b])
+                travail.insert(p);
+        }
+    }
+
+    bool change = false;
+    vector<bool> supprimee(lignes.size(), false);
+    for (size_t b = 0; b < blocs.size(); b++) {
+        Ensemble vivantes = Sortie(b);
+        for (size_t i = blocs[b].fin; i-- > blocs[b].debut; ) {
+            const InstructionAsm& ins = code[i];
+            if (effets[i].ecrite >= 0 && !Vivante(vivantes, effets[i].ecrite) && !supprimee[i]) {
+                string cible = NomGlobal(ins.operandes[ins.mnemonique == "pop" ? 0 : 1]);
+                change = true;
+                long m = ins.mnemonique == "pop" ? DebutCalcul(lignes, blocs[b].debut, i) : -1;
+                if (ins.mnemonique == "movq")
+                    supprimee[i] = true;
+                else if (m >= 0)
+                    for (long k = m + 1; k <= (long) i; k++)
+                        supprimee[k] = supprimee[k] || !code[k].mnemonique.empty();
+                else
+                    lignes[i] = "\taddq $8, %rsp\t# écriture inutile de " + cible;
+                continue;                   // l'écriture supprimée ne tue rien
+            }
+            if (!supprimee[i])
+                Transfert(effets[i], vivantes);
+        }
+    }
+
+    vector<string> resultat;
+    for (size_t i = 0; i < lignes.size(); i++)
+        if (!supprimee[i])
+            resultat.push_back(lignes[i]);
+    lignes = resultat;
+    return change;
+}
+
+// Propagation des constantes et code mort sur le texte du programme principal
+void PropagationEtCodeMort(string& principal) {
+    VarsSuivies.clear();
+    for (auto& v : DeclaredVars)
+        if (TailleType(v.second) == 8) {
+            int n = VarsSuivies.size();
+            VarsSuivies[v.first] = n;
+        }
+    // Estimation rapide de la taille avant tout découpage : lignes, plus long
+    // bloc, et blocs (étiquettes plus sauts, au plus le double du vrai nombre :
+    // un saut suivi d'une étiquette). Le coût de la passe est proportionnel aux
+    // lignes, avec un facteur bien plus grand que celui de l'analyse (chaque ligne
+    // est décodée) ; un très long bloc sans branchement (une longue expression)
+    // coûte beaucoup pour peu de décisions : la passe est alors sautée
+    unsigned long long blocs = 1, nbLignes = 0, debutBloc = 0, plusLongBloc = 0;
+    for (const char* p = principal.c_str(); (p = strchr(p, '\n')) != NULL && p[1] != '\0'; p++) {
+        nbLignes++;
+        if (p[1] == '.' || isalpha(p[1]) || (p[1] == '\t' && p[2] == 'j')) {
+            blocs++;
+            plusLongBloc = max(plusLongBloc, nbLignes - debutBloc);
+            debutBloc = nbLignes;
+        }
+    }
+    plusLongBloc = max(plusLongBloc, nbLignes - debutBloc);
+    if (nbLignes > PROPAGATION_LIGNES_MAX || plusLongBloc > PROPAGATION_BLOC_MAX
+        || blocs * (VarsSuivies.size() + 1) > 2 * PROPAGATION_TAILLE_MAX)
+        return;
+
+    // Une instruction par ligne ("NOM:\tinstr" en deux lignes) ; les parties
+    // froides (.pushsection) sont déplacées à la fin : elles sont dans une autre
+    // section, leur place dans le texte ne change pas le programme
+    vector<string> lignes, froides;
+    bool froid = false;
+    for (auto& l : Lignes(principal)) {
+        size_t fin = l.find(":\t");
+        if (!l.empty() && l[0] != '\t' && l[0] != ' ' && l[0] != '#' && fin != string::npos
+            && l.find_first_of(" \t") > fin) {
+            (froid ? froides : lignes).push_back(l.substr(0, fin + 1));
+            (froid ? froides : lignes).push_back(l.substr(fin + 1));
+            continue;
+        }
+        if (l.compare(0, 13, "\t.pushsection") == 0)
+            froid = true;
+        bool finFroid = l.compare(0, 12, "\t.popsection") == 0;
+        (froid ? froides : lignes).push_back(move(l));
+        if (finFroid)
+            froid = false;
+    }
+    lignes.insert(lignes.end(), froides.begin(), froides.end());
+
+    if (!PropagationConstantes(lignes))
+        return;                             // trop grand ou sauts inconnus : texte inchangé
+    for (unsigned passe = 0; passe < 10 && EcrituresMortes(lignes); passe++)
+        ;
+    principal = Texte(lignes);
+}
+
+// 3. Variables globales encore référencées par le code émis
+void NoteVariablesUtilisees(const string& texte) {
+    for (auto& l : Lignes(texte))
+        for (auto& o : Decode(l).operandes) {
+            string nom = NomGlobal(o);
+            if (!nom.empty())
+                VariablesUtilisees.insert(nom);
+        }
+}
+
+
+// Place les variables globales dans .bss (elles sont toutes initialisées à zéro)
+// - les variables que le code ne référence plus ne sont pas placées (sauf avec
+//   --layout=declaration, qui garde toutes les variables dans l'ordre de déclaration)
+// - chaque variable est alignée sur sa taille (8 pour INTEGER/BOOLEAN/DOUBLE, 1 pour CHAR)
+// - les variables les plus chaudes d'une même boucle sont regroupées sur une ligne de cache
+// - un groupe qui tient dans une ligne n'est jamais coupé en deux
+void DataSection() {
+    if (DispositionDeclaration) {
+        // Ancienne disposition : ordre de déclaration, variables collées les unes
+        // aux autres sans alignement propre ; seul le début de .bss est aligné sur
+        // une ligne de cache, pour que les variables à cheval sur deux lignes soient
+        // les mêmes d'une édition de liens à l'autre (make bench-layout). Toutes les
+        // variables sont gardées pour que les décalages ne dépendent pas des passes
+        cout << "\t.bss" << endl;
+        cout << "\t.balign " << LIGNE_CACHE << endl;
+        for (auto& nom : OrdreDeclaration)
+            cout << nom << ":\t.zero " << TailleType(DeclaredVars[nom]) << endl;
+        return;
+    }
+
+    // Regroupement par boucle « maison » (0 = variables hors boucle)
+    map<unsigned long, vector<string>> groupes;
+    map<unsigned long, unsigned long long> chaleur;
+    for (auto& nom : OrdreDeclaration) {
+        if (PropagationActive && !VariablesUtilisees.count(nom))
+            continue;                   // plus aucune référence (PropagationEtCodeMort)
+        unsigned long boucle = BoucleMaison[nom];
+        groupes[boucle].push_back(nom);
+        chaleur[boucle] = max(chaleur[boucle], PoidsMaison[nom]);
+    }
+
+    vector<unsigned long> ordre;
+    for (auto& g : groupes)
+        ordre.push_back(g.first);
+    stable_sort(ordre.begin(), ordre.end(), [&](unsigned long a, unsigned long b) {
+        return chaleur[a] > chaleur[b];
+    });
+
+    cout << "\t.bss" << endl;
+    cout << "\t.balign " << LIGNE_CACHE << endl;
+
+    unsigned long position = 0;  // décalage depuis le début de .bss
+    for (auto boucle : ordre) {
+        vector<string>& vars = groupes[boucle];
+        // Les grandes tailles d'abord : aucun octet de bourrage dans le groupe
+        stable_sort(vars.begin(), vars.end(), [](const string& a, const string& b) {
+            unsigned ta = TailleType(DeclaredVars[a]), tb = TailleType(DeclaredVars[b]);
+            if (ta != tb) return ta > tb;
+            return PoidsVar[a] > PoidsVar[b];
+        });
+
+        unsigned long tailleGroupe = 0;
+        for (auto& nom : vars)
+            tailleGroupe += TailleType(DeclaredVars[nom]);
+        if (boucle != 0 && tailleGroupe <= LIGNE_CACHE
+            && position % LIGNE_CACHE + tailleGroupe > LIGNE_CACHE) {
+            cout << "\t.balign " << LIGNE_CACHE << "\t# groupe de la boucle " << boucle << endl;
+            position = (position + LIGNE_CACHE - 1) / LIGNE_CACHE * LIGNE_CACHE;
+        }
+
+        for (auto& nom : vars) {
+            unsigned taille = TailleType(DeclaredVars[nom]);
+            if (position % taille != 0) {
+                cout << "\t.balign " << taille << endl;
+                position = (position + taille - 1) / taille * taille;
+            }
+            cout << nom << ":\t.zero " << taille << endl;
+            position += taille;
+        }
+    }
+}
+
+
+// Écriture des compteurs dans le fichier de profil à la fin de main
+// (--profile-generate) : une ligne "<clé> <nombre>" par compteur
+void EcritureProfil() {
+    if (!ProfilGeneration)
+        return;
+    cout << "\t\t\t# écriture du profil d'exécution" << endl;
+    cout << "\tpush %rbx\n\tpush %r12" << endl;
+    cout << "\tmovq $ProfilFichier, %rdi\n\tmovq $ProfilMode, %rsi" << endl;
+    cout << "\tcall fopen@PLT" << endl;
+    cout << "\tmovq %rax, %r12" << endl;
+    cout << "\tcmpq $0, %rax\n\tje ProfilFin" << endl;
+    cout << "\tmovq $0, %rbx" << endl;
+    cout << "ProfilBoucle:" << endl;
+    cout << "\tcmpq $" << NomsCompteurs.size() << ", %rbx\n\tjae ProfilFerme" << endl;
+    cout << "\tmovq %r12, %rdi" << endl;
+    cout << "\tmovq ProfilNoms(,%rbx,8), %rsi" << endl;
+    cout << "\tmovq PROFIL(,%rbx,8), %rdx" << endl;
+    cout << "\tmovl $0, %eax" << endl;
+    cout << "\tcall fprintf@PLT" << endl;
+    cout << "\tincq %rbx\n\tjmp ProfilBoucle" << endl;
+    cout << "ProfilFerme:" << endl;
+    cout << "\tmovq %r12, %rdi\n\tcall fclose@PLT" << endl;
+    cout << "ProfilFin:" << endl;
+    cout << "\tpop %r12\n\tpop %rbx" << endl;
+}
+
+// Compteurs dans .bss, noms et fichier du profil dans .rodata (--profile-generate)
+void ProfilSection() {
+    if (!ProfilGeneration)
+        return;
+    cout << "\t.bss" << endl;
+    cout << "\t.balign " << LIGNE_CACHE << endl;
+    cout << "PROFIL:\t.zero " << 8 * max<size_t>(NomsCompteurs.size(), 1) << endl;
+    cout << "\t.section .rodata" << endl;
+    cout << "ProfilFichier:\t.string \"" << FichierProfil << "\"" << endl;
+    cout << "ProfilMode:\t.string \"w\"" << endl;
+    cout << "\t.balign 8" << endl;
+    cout << "ProfilNoms:" << endl;
+    for (size_t k = 0; k < NomsCompteurs.size(); k++)
+        cout << "\t.quad ProfilNom" << k << endl;
+    for (size_t k = 0; k < NomsCompteurs.size(); k++)
+        cout << "ProfilNom" << k << ":\t.string \"" << NomsCompteurs[k] << " %llu\\n\"" << endl;
+}
+
+
+// === Rapport --annotate ===
+// Lit sur l'entrée standard la sortie de "perf script -F ip,srcline" : chaque
+// échantillon y est suivi de sa position "fichier:ligne" (tirée des .loc).
+// Affiche le source avec, pour chaque ligne, son nombre d'échantillons.
+// Usage : perf record ./prog ; perf script -F ip,srcline | ./compilateur --annotate=prog.p
+int Annotation(const string& nom) {
+    ifstream fichier(nom.c_str());
+    if (!fichier) {
+        cerr << "Fichier source introuvable : " << nom << endl;
+        return 1;
+    }
+    vector<string> source;
+    string l;
+    while (getline(fichier, l))
+        source.push_back(l);
+
+    // Les positions peuvent être relatives ou absolues : on compare le dernier composant
+    string base = nom.substr(nom.find_last_of('/') + 1);
+    vector<unsigned long> echantillons(source.size() + 1, 0);
+    unsigned long total = 0, ailleurs = 0;
+    while (getline(cin, l)) {
+        size_t debut = l.find_first_not_of(" \t");
+        size_t deuxPoints = l.rfind(':');
+        if (debut == string::npos || deuxPoints == string::npos || deuxPoints < debut
+            || l.find_first_of(" \t", debut) != string::npos
+            || deuxPoints + 1 == l.size()
+            || l.find_first_not_of("0123456789", deuxPoints + 1) != string::npos)
+            continue;                   // pas une ligne "fichier:ligne"
+        total++;
+        string chemin = l.substr(debut, deuxPoints - debut);
+        unsigned long ligne = strtoul(l.c_str() + deuxPoints + 1, NULL, 10);
+        bool memeFichier = chemin.size() >= base.size()
+                           && chemin.compare(chemin.size() - base.size(), base.size(), base) == 0
+                           && (chemin.size() == base.size() || chemin[chemin.size() - base.size() - 1] == '/');
+        if (memeFichier && ligne >= 1 && ligne <= source.size())
+            echantillons[ligne]++;
+        else
+            ailleurs++;
+    }
+
+    cout << nom << " : " << total << " échantillons, " << ailleurs
+         << " hors du source (bibliothèque C, noyau, ...)" << endl;
+    cout << " échantillons       %  ligne  source" << endl;
+    for (size_t i = 1; i <= source.size(); i++) {
+        ostringstream colonnes;
+        colonnes.setf(ios::fixed);
+        colonnes.precision(1);
+        if (echantillons[i]) {
+            colonnes.width(12);
+            colonnes << echantillons[i];
+            colonnes.width(7);
+            colonnes << 100.0 * echantillons[i] / total << "%";
+        }
+        else
+            colonnes << string(20, ' ');
+        colonnes.width(7);
+        colonnes << i << "  " << source[i - 1];
+        cout << colonnes.str() << endl;
+    }
+    return 0;
+}
+
+
+// === Mesures du compilateur (--stats) ===
+// Le source est d'abord lu en mémoire et découpé une fois en lexèmes, pour
+// chronométrer l'analyse lexicale seule. Les mesures sont écrites sur cerr,
+// une par ligne : "stats <clé> <valeur>" (lues par bench/bench_compile.sh).
+bool Statistiques = false;
+typedef chrono::steady_clock Horloge;
+
+double Millisecondes(Horloge::time_point debut, Horloge::time_point fin) {
+    return chrono::duration<double, milli>(fin - debut).count();
+}
+
+
 // Point d'entrée principal du compilateur
 
 
 
-int main(void) {
-    // Entête du code assembleur
-    cout << "\t\t\t# Code généré automatiquement par MonCompilateur" << endl;
-    cout << "\t.extern printf" << endl; // appel à printf
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--layout=declaration")
+            DispositionDeclaration = true;
+        else if (option == "--no-inline")
+            ExpansionEnLigneActive = false;
+        else if (option == "--no-if-conversion")
+            ConversionSiActive = false;
+        else if (option == "--no-sccp")
+            PropagationActive = false;
+        else if (option == "--unroll-loops")
+            DeroulageActif = true;
+        else if (option == "--stats")
+            Statistiques = true;
+        else if (option == "--debug")
+            Traces = true;
+        else if (option.compare(0, 18, "--profile-generate") == 0 && (option.size() == 18 || option[18] == '=')) {
+            ProfilGeneration = true;
+            if (option.size() > 18)
+                FichierProfil = option.substr(19);
+        }
+        else if (option.compare(0, 13, "--profile-use") == 0 && (option.size() == 13 || option[13] == '=')) {
+            ProfilUtilisation = true;
+            if (option.size() > 13)
+                FichierProfil = option.substr(14);
+        }
+        else if (option.compare(0, 11, "--annotate=") == 0)
+            return Annotation(option.substr(11));
+        else if (option.compare(0, 2, "--") != 0 && NomSource == "<stdin>")
+            NomSource = option;
+        else {
+            cerr << "Option inconnue : " << option << endl;
+            return 1;
+        }
+    }
 
-    current = (TOKEN) lexer->yylex();
-        Program();
+    if (ProfilGeneration && ProfilUtilisation) {
+        cerr << "--profile-generate et --profile-use sont incompatibles" << endl;
+        return 1;
+    }
+    if (ProfilUtilisation) {
+        ifstream profil(FichierProfil.c_str());
+        if (!profil) {
+            cerr << "Profil introuvable : " << FichierProfil << endl;
+            return 1;
+        }
+        string cle;
+        unsigned long long n;
+        while (profil >> cle >> n)
+            Profil[cle] += n;
+    }
 
-    // Affichage de la variable a
-    cout << "\tmovq a, %rsi" << endl;
-    cout << "\tleaq msg_a(%rip), %rdi" << endl;
-    cout << "\txor %rax, %rax" << endl;
-    cout << "\tcall printf" << endl;
+    // Source : fichier donné en argument, sinon l'entrée standard
+    istream* entree = &cin;
+    ifstream fichier;
+    if (NomSource != "<stdin>") {
+        fichier.open(NomSource.c_str());
+        if (!fichier) {
+            cerr << "Fichier source introuvable : " << NomSource << endl;
+            return 1;
+        }
+        entree = &fichier;
+        delete lexer;
+        lexer = new Lexer(entree);
+    }
 
-    // Affichage de la variable b
-    cout << "\tmovq b, %rsi" << endl;
-    cout << "\tleaq msg_b(%rip), %rdi" << endl;
-    cout << "\txor %rax, %rax" << endl;
-    cout << "\tcall printf" << endl;
+    Horloge::time_point debut = Horloge::now(), lu = debut, decoupe = debut;
+    istringstream source;
+    unsigned long nbLexemes = 0, nbLignes = 0;
+    if (Statistiques) {
+        ostringstream lecture;
+        lecture << entree->rdbuf();
+        string texte = lecture.str();
+        source.str(texte);
+        lu = Horloge::now();
+
+        // Analyse lexicale seule, sur une copie (Flex recopie les caractères inconnus sur cout)
+        istringstream copie(texte);
+        ostringstream ignore;
+        streambuf* sortie = cout.rdbuf(ignore.rdbuf());
+        Lexer compteur(&copie);
+        while (compteur.yylex() != FEOF)
+            nbLexemes++;
+        cout.rdbuf(sortie);
+        nbLignes = count(texte.begin(), texte.end(), '\n');
+        decoupe = Horloge::now();
+
+        delete lexer;
+        lexer = new Lexer(&source);
+    }
 
+    // Entête du code assembleur
+    cout << "\t\t\t# Code généré automatiquement par MonCompilateur" << endl;
+    cout << "\t.extern printf" << endl; // appel à printf
+    string nomFichier = NomSource;              // .file : le nom entre guillemets
+    for (size_t i = 0; i < nomFichier.size(); i++)
+        if (nomFichier[i] == '"' || nomFichier[i] == '\\')
+            nomFichier.insert(i++, "\\");
+    cout << "\t.file 1 \"" << nomFichier << "\"" << endl;
 
+    // Le programme principal est généré dans un tampon pour l'expansion en ligne
+    ostringstream principal;
+    streambuf* sortie = cout.rdbuf(principal.rdbuf());
 
-    // Affichage de la variable c
-    cout << "\tmovq c, %rsi" << endl;
-    cout << "\tleaq msg_c(%rip), %rdi" << endl;
-    cout << "\txor %rax, %rax" << endl;
-    cout << "\tcall printf" << endl;
+    current = (TOKEN) lexer->yylex();
+        Program();
 
-    // Affichage de la variable z
-    cout << "\tmovq z, %rsi" << endl;
-    cout << "\tleaq msg_z(%rip), %rdi" << endl;
-    cout << "\txor %rax, %rax" << endl;
-    cout << "\tcall printf" << endl;
+    // Affichage final des variables a, b, c et z (seulement si elles sont déclarées)
+    const char* affichees[] = {"a", "b", "c", "z"};
+    for (const char* v : affichees) {
+        if (!VariableConnue(v)) continue;
+        if (DeclaredVars[v] == CHAR_TYPE)
+            cout << "\tmovzbq " << v << ", %rsi" << endl;
+        else
+            cout << "\tmovq " << v << ", %rsi" << endl;
+        cout << "\tleaq msg_" << v << "(%rip), %rdi" << endl;
+        cout << "\txor %rax, %rax" << endl;
+        cout << "\tcall printf" << endl;
+    }
 
+    EcritureProfil();
+
+    // Épilogue du programme assembleur (code de retour 0)
+    cout << "\tmovq $0, %rax" << endl;
+    cout << "\tmovq %rbp, %rsp\n\tpop %rbp\n\tret" << endl;
+
+    cout.rdbuf(sortie);
+    Horloge::time_point analyse = Horloge::now();
+    string texte = principal.str();
+    ExpansionEnLigne(texte);
+    if (PropagationActive)
+        PropagationEtCodeMort(texte);
+    Horloge::time_point passes = Horloge::now();
+    cout << texte;
+    NoteVariablesUtilisees(texte);
+
+    // Sous-programmes encore appelés après l'expansion en ligne
+    for (auto& nom : OrdreSousProgrammes)
+        if (SousProgrammes[nom].nbAppels > 0) {
+            cout << SousProgrammes[nom].code;
+            NoteVariablesUtilisees(SousProgrammes[nom].code);
+        }
 
-    // Épilogue du programme assembleur
-    cout << "\tmovq %rbp, %rsp\n\tret" << endl;
+    // Variables globales
+    DataSection();
+    ProfilSection();
 
     // Section de données en lecture seule pour le message
     cout << "\t.section .rodata" << endl;
-    cout << "msg_a:\t.string \"Valeur de a : %ld\\n\"" << endl;
-    cout << "msg_b:\t.string \"Valeur de b : %ld\\n\"" << endl;
-    cout << "msg_c:\t.string \"Valeur de c : %ld\\n\"" << endl;
-    cout << "msg_z:\t.string \"Valeur de z : %ld\\n\"" << endl;
+    for (const char* v : affichees)
+        if (VariableConnue(v))
+            cout << "msg_" << v << ":\t.string \"Valeur de " << v << " : %ld\\n\"" << endl;
     
     cout << "DisplayMsg:\t.string \"Résultat : %llu\\n\"\t# affichage entier 64 bits" << endl;
     cout << "FormatString1:\t.string \"%llu\\n\"\t# affichage brut sans message" << endl;
 
+    cout << "FormatString2:\t.string \"%f\\n\"\t# affichage d'un double" << endl;
+    cout << "FormatString3:\t.string \"%c\\n\"\t# affichage d'un caractère" << endl;
+
     cout << "TrueString:\t.string \"TRUE\\n\"" << endl;
     cout << "FalseString:\t.string \"FALSE\\n\"" << endl;
 
@@ -856,5 +3086,24 @@ int main(void) {
     if (current != FEOF)
         Erreur("Il reste du contenu après la fin du programme.");
 
+    if (Statistiques) {
+        cout.flush();
+        Horloge::time_point fin = Horloge::now();
+        double total = Millisecondes(debut, fin);
+        struct rusage ressources;
+        getrusage(RUSAGE_SELF, &ressources);
+        cerr << "stats lignes " << nbLignes << endl;
+        cerr << "stats lexemes " << nbLexemes << endl;
+        cerr << "stats lecture_ms " << Millisecondes(debut, lu) << endl;
+        cerr << "stats lexical_ms " << Millisecondes(lu, decoupe) << endl;
+        cerr << "stats analyse_ms " << Millisecondes(decoupe, analyse) << endl;     // syntaxe et génération
+        cerr << "stats passes_ms " << Millisecondes(analyse, passes) << endl;       // expansion en ligne, propagation des constantes
+        cerr << "stats emission_ms " << Millisecondes(passes, fin) << endl;
+        cerr << "stats total_ms " << total << endl;
+        cerr << "stats lexemes_par_s " << (unsigned long)(nbLexemes / (total / 1000)) << endl;
+        cerr << "stats lignes_par_s " << (unsigned long)(nbLignes / (total / 1000)) << endl;
+        cerr << "stats rss_max_ko " << ressources.ru_maxrss << endl;
+    }
+
     return 0;
 }
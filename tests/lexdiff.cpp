@@ -0,0 +1,49 @@
+// Test différentiel des deux analyseurs lexicaux : le lexer Flex++ (tokeniser.l,
+// la référence) et SimdLexer (tokeniser_simd.cpp) doivent produire les mêmes
+// lexèmes (type, texte et ligne) sur chaque fichier.
+// Usage : lexdiff fichier.p...   (code de retour 1 à la première différence)
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <FlexLexer.h>
+#include "tokeniser_simd.h"
+
+using namespace std;
+
+// Compare les deux suites de lexèmes d'un fichier
+bool Compare(const string& nom) {
+    ifstream a(nom.c_str()), b(nom.c_str());
+    if (!a || !b) {
+        cerr << "Impossible d'ouvrir " << nom << endl;
+        return false;
+    }
+    ostringstream echo;                 // caractères non reconnus recopiés par Flex
+    yyFlexLexer reference(&a, &echo);
+    SimdLexer simd(&b);
+
+    for (unsigned long n = 1; ; n++) {
+        int t1 = reference.yylex();
+        int t2 = simd.yylex();
+        string x1 = (t1 == FEOF) ? "" : reference.YYText();
+        string x2 = (t2 == FEOF) ? "" : simd.YYText();
+        if (t1 != t2 || x1 != x2 || reference.lineno() != simd.lineno()) {
+            cerr << nom << " : lexème " << n << " différent" << endl;
+            cerr << "  flex : " << t1 << " '" << x1 << "' ligne " << reference.lineno() << endl;
+            cerr << "  simd : " << t2 << " '" << x2 << "' ligne " << simd.lineno() << endl;
+            return false;
+        }
+        if (t1 == FEOF) {
+            cout << "OK " << nom << " (" << n << " lexèmes)" << endl;
+            return true;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool ok = true;
+    for (int i = 1; i < argc; i++)
+        ok = Compare(argv[i]) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+// Suite des lexèmes produite par SimdLexer (tokeniser_simd.cpp), une ligne par
+// lexème : "ligne TYPE 'texte'". Sans flex++ : make test-lexer-simd compare la
+// sortie sur tests/test_lexemes.p au fichier attendu tests/test_lexemes.lexemes.
+// Usage : lexemes fichier.p
+
+#include <iostream>
+#include <fstream>
+#include "tokeniser_simd.h"
+
+using namespace std;
+
+// Noms des TOKEN, dans l'ordre de l'enum de tokeniser.h
+const char* NOMS[] = {
+    "FEOF", "UNKNOWN", "NUMBER", "ID", "STRINGCONST", "RBRACKET", "LBRACKET",
+    "RPARENT", "LPARENT", "COMMA", "SEMICOLON", "DOT", "ADDOP", "MULOP",
+    "RELOP", "NOT", "ASSIGN", "MOTCLE", "COLON", "DOUBLE_CONST_TOKEN",
+    "CHARCONST_TOKEN", "DOUBLE_TYPE_TOKEN", "DOTDOT"
+};
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        cerr << "Usage : lexemes fichier.p" << endl;
+        return 1;
+    }
+    ifstream f(argv[1]);
+    if (!f) {
+        cerr << "Impossible d'ouvrir " << argv[1] << endl;
+        return 1;
+    }
+    SimdLexer lexer(&f);
+    int t;
+    do {
+        t = lexer.yylex();
+        cout << lexer.lineno() << " " << NOMS[t] << " '" << (t == FEOF ? "" : lexer.YYText()) << "'" << endl;
+    } while (t != FEOF);
+    return 0;
+}
@@ -0,0 +1,18 @@
+(* Plus de 6 arguments entiers et de 8 arguments DOUBLE : les suivants
+   passent par la pile, comme dans la convention System V *)
+VAR x : INTEGER; d : DOUBLE.
+FUNCTION somme(a, b, c, e, f, g, h, i : INTEGER) : INTEGER;
+BEGIN somme := a + 10 * (b + 10 * (c + 10 * (e + 10 * (f + 10 * (g + 10 * (h + 10 * i)))))) END;
+FUNCTION mixte(a : INTEGER; u, v, w, y, z, t, r, s, q, p : DOUBLE; b, c, e, f, g, h, k : INTEGER) : DOUBLE;
+BEGIN
+    DISPLAY a + b + c + e + f + g + h + k;
+    DISPLAY p;
+    mixte := u + v + w + y + z + t + r + s + q + p
+END;
+BEGIN
+    x := 1 + somme(1, 2, 3, 4, 5, 6, 7, 8);
+    DISPLAY x;
+    d := 0.5 + mixte(1, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 2, 3, 4, 5, 6, 7, 8);
+    DISPLAY d;
+    DISPLAY somme(8, 7, 6, 5, 4, 3, 2, 1)
+END.
@@ -0,0 +1,31 @@
+(* CASE dont les étiquettes couvrent les 2^64 valeurs du sélecteur,
+   et étiquettes au-delà de 2^31 (lues comme les entiers des expressions) *)
+VAR x, y : INTEGER.
+BEGIN
+    x := 1;
+    CASE x OF
+        0, 2..18446744073709551615: DISPLAY 1;
+        1: DISPLAY 2
+    END;
+    CASE x OF
+        0..18446744073709551615: DISPLAY 3
+    END;
+    y := 3000000000;
+    CASE y OF
+        1: DISPLAY 4;
+        3000000000: DISPLAY 5;
+        18446744073709551615: DISPLAY 6
+    END;
+    y := 18446744073709551615;
+    CASE y OF
+        2999999999..3000000004, 3000000006: DISPLAY 7;
+        3000000005: DISPLAY 8;
+        18446744073709551614..18446744073709551615: DISPLAY 9
+    END;
+    y := 3000000005;
+    CASE y OF
+        3000000000, 3000000002..3000000004: DISPLAY 10;
+        3000000001, 3000000005: DISPLAY 11
+    END;
+    DISPLAY y + 4294967296
+END.
@@ -0,0 +1,11 @@
+(* Sous-programme copié en ligne qui appelle printf avec un DOUBLE :
+   la pile doit rester alignée sur 16 octets dans la copie *)
+VAR x : DOUBLE.
+PROCEDURE p(d : DOUBLE);
+BEGIN
+    DISPLAY d
+END;
+BEGIN
+    x := 1.5;
+    p(x)
+END.
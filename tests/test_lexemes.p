@@ -0,0 +1,22 @@
+(* Tous les lexèmes du langage, pour le test différentiel des analyseurs lexicaux
+   (make test-lexer) et pour la suite attendue du lexer SIMD (make test-lexer-simd,
+   tests/test_lexemes.lexemes) : ce commentaire contient des ** étoiles *, des (parenthèses)
+   et plusieurs lignes *)
+VAR
+    a1, B2, c : INTEGER; x : DOUBLE; k : CHAR; f : BOOLEAN.
+PROCEDURE p(u, v : INTEGER);
+BEGIN DISPLAY u END;
+FUNCTION carre(y : INTEGER) : INTEGER;
+BEGIN carre := y * y END;
+BEGIN
+    a1 := 12 + 3 - 4 * 5 / 6 % 7;
+    f := (a1 == B2) || (a1 != c) && !(a1 < 1) && (a1 > 2) && (a1 <= 3) && (a1 >= 4);
+    x := 3.14 * 2.0;(**)
+    k := 'Z'; k := ' '; k := '+';
+    CASE a1 OF 1..5, 7: c := 1; 8: c := 2 ELSE c := 3 END;
+    IF f THEN c := 1 ELSE c := 2;
+    WHILE c < 10 DO c := c + 1;
+    FOR a1 := 1 TO 10 DO p(a1, carre(a1));
+    [a1, c] "chaîne" @ # $ ~ ? ^ { } _a1 ` 1.x 12..
+    ABEGIN BEGINX IF2 END12 DISPLAYx VARIABLE
+END.
@@ -0,0 +1,21 @@
+(* Sous-programmes nommés comme des symboles de la libc, comme main ou comme
+   des étiquettes générées par le compilateur *)
+VAR x : INTEGER.
+FUNCTION printf(a : INTEGER) : INTEGER;
+BEGIN printf := a + 1 END;
+FUNCTION ALORS1(n : INTEGER) : INTEGER;
+BEGIN IF n == 0 THEN ALORS1 := 0 ELSE ALORS1 := ALORS1(n - 1) END;
+PROCEDURE FormatString1(a : INTEGER);
+BEGIN DISPLAY a END;
+PROCEDURE main;
+BEGIN
+    x := printf(41);
+    FormatString1(x)
+END;
+PROCEDURE puts(v : INTEGER);
+BEGIN IF v > 2 THEN DISPLAY v ELSE DISPLAY 0 END;
+BEGIN
+    main;
+    puts(3); puts(1);
+    DISPLAY ALORS1(5) + printf(1)
+END.
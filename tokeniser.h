@@ -8,13 +8,15 @@ enum TOKEN {
     RPARENT, LPARENT, COMMA, SEMICOLON, DOT, ADDOP, MULOP,
     RELOP, NOT, ASSIGN, MOTCLE, COLON,     DOUBLE_CONST_TOKEN,   // suffixe _TOKEN
     CHARCONST_TOKEN,
-    DOUBLE_TYPE_TOKEN 
+    DOUBLE_TYPE_TOKEN,
+    DOTDOT              // ".." des intervalles du CASE
 };
 
 // Juste la **déclaration** de l'enum des mots-clés
 enum MOTCLEVAL {
     IF_, THEN_, ELSE_, WHILE_, DO_, FOR_, TO_, BEGIN_, END_,
-    DISPLAY_, VAR_, BOOLEAN_, INTEGER_, CHAR_KEYWORD_, DOUBLE_KEYWORD_, UNKNOWN_KEYWORD
+    DISPLAY_, VAR_, BOOLEAN_, INTEGER_, CHAR_KEYWORD_, DOUBLE_KEYWORD_, CASE_, OF_,
+    PROCEDURE_, FUNCTION_, UNKNOWN_KEYWORD
 };
 
 
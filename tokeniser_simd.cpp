@@ -0,0 +1,342 @@
+// Analyseur lexical écrit à la main (voir tokeniser_simd.h)
+// Il reconnaît exactement les mêmes lexèmes que tokeniser.l : à chaque position,
+// le lexème le plus long l'emporte, et à longueur égale la règle écrite la
+// première dans tokeniser.l. Les caractères qu'aucune règle ne reconnaît
+// (ECHO de Flex) sont ignorés.
+// Compilation : g++ -O2 -c tokeniser_simd.cpp (l'AVX2 est choisi à l'exécution)
+
+#include "tokeniser_simd.h"
+#include <cstring>
+#include <immintrin.h>
+
+using namespace std;
+
+static const size_t TAILLE_LOT = 4096;      // lexèmes par lot
+static const size_t MARGE = 64;             // zéros après le source (lectures de 32 octets)
+
+
+// === Balayages vectoriels ===
+// Chaque fonction part de p et s'arrête au premier octet qui ne fait plus partie
+// de la suite cherchée ; les zéros de la marge arrêtent toutes les suites.
+
+// Octets de [lo, hi] (comparaisons signées : les octets >= 0x80 sont exclus)
+static inline __m128i PlageSse2(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+}
+
+static inline __m128i BlancsVecSse2(__m128i v) {
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                     _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                     _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+}
+
+// Longueur de la suite [ \t\n\r]* ; ajoute à *nl le nombre de '\n' traversés
+static size_t BlancsSse2(const char* p, int* nl) {
+    for (size_t i = 0; ; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        unsigned blancs = _mm_movemask_epi8(BlancsVecSse2(v));
+        unsigned sauts = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        if (blancs != 0xFFFF) {
+            unsigned n = __builtin_ctz(~blancs);
+            *nl += __builtin_popcount(sauts & ((1u << n) - 1));
+            return i + n;
+        }
+        *nl += __builtin_popcount(sauts);
+    }
+}
+
+// Longueur de la suite [A-Za-z0-9]*
+static size_t AlnumSse2(const char* p) {
+    for (size_t i = 0; ; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i lettres = PlageSse2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+        unsigned m = _mm_movemask_epi8(_mm_or_si128(lettres, PlageSse2(v, '0', '9')));
+        if (m != 0xFFFF)
+            return i + __builtin_ctz(~m);
+    }
+}
+
+// Longueur de la suite [0-9]*
+static size_t ChiffresSse2(const char* p) {
+    for (size_t i = 0; ; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        unsigned m = _mm_movemask_epi8(PlageSse2(v, '0', '9'));
+        if (m != 0xFFFF)
+            return i + __builtin_ctz(~m);
+    }
+}
+
+// Fin d'un commentaire dont le "(*" est déjà passé : longueur jusqu'après "*)",
+// ou n si le commentaire n'est pas fermé ; ajoute les '\n' traversés à *nl
+static size_t CommentaireSse2(const char* p, size_t n, int* nl) {
+    for (size_t i = 0; i < n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        unsigned etoiles = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+        unsigned sauts = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        while (etoiles) {
+            unsigned k = __builtin_ctz(etoiles);
+            if (i + k + 1 >= n)
+                break;
+            if (p[i + k + 1] == ')') {
+                *nl += __builtin_popcount(sauts & ((1u << k) - 1));
+                return i + k + 2;
+            }
+            etoiles &= etoiles - 1;
+        }
+        if (i + 16 >= n) {
+            *nl += __builtin_popcount(sauts & ((1u << (n - i)) - 1));
+            return n;
+        }
+        *nl += __builtin_popcount(sauts);
+    }
+    return n;
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i PlageAvx2(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+__attribute__((target("avx2")))
+static size_t BlancsAvx2(const char* p, int* nl) {
+    for (size_t i = 0; ; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i b = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                     _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        unsigned blancs = _mm256_movemask_epi8(b);
+        unsigned sauts = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        if (blancs != 0xFFFFFFFFu) {
+            unsigned n = __builtin_ctz(~blancs);
+            *nl += __builtin_popcount(sauts & ((1ull << n) - 1));
+            return i + n;
+        }
+        *nl += __builtin_popcount(sauts);
+    }
+}
+
+__attribute__((target("avx2")))
+static size_t AlnumAvx2(const char* p) {
+    for (size_t i = 0; ; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i lettres = PlageAvx2(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+        unsigned m = _mm256_movemask_epi8(_mm256_or_si256(lettres, PlageAvx2(v, '0', '9')));
+        if (m != 0xFFFFFFFFu)
+            return i + __builtin_ctz(~m);
+    }
+}
+
+__attribute__((target("avx2")))
+static size_t ChiffresAvx2(const char* p) {
+    for (size_t i = 0; ; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        unsigned m = _mm256_movemask_epi8(PlageAvx2(v, '0', '9'));
+        if (m != 0xFFFFFFFFu)
+            return i + __builtin_ctz(~m);
+    }
+}
+
+__attribute__((target("avx2")))
+static size_t CommentaireAvx2(const char* p, size_t n, int* nl) {
+    for (size_t i = 0; i < n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        unsigned etoiles = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+        unsigned sauts = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        while (etoiles) {
+            unsigned k = __builtin_ctz(etoiles);
+            if (i + k + 1 >= n)
+                break;
+            if (p[i + k + 1] == ')') {
+                *nl += __builtin_popcount(sauts & ((1ull << k) - 1));
+                return i + k + 2;
+            }
+            etoiles &= etoiles - 1;
+        }
+        if (i + 32 >= n) {
+            *nl += __builtin_popcount(sauts & ((1ull << (n - i)) - 1));
+            return n;
+        }
+        *nl += __builtin_popcount(sauts);
+    }
+    return n;
+}
+
+
+// Balayages retenus pour ce processeur
+static bool AvecAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+const char* SimdLexer::JeuInstructions() {
+    return AvecAvx2() ? "avx2" : "sse2";
+}
+
+
+// === Classes de caractères ===
+
+static bool EstAlpha(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+static bool EstChiffre(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Règle {unknown} de tokeniser.l : tout sauf ces caractères
+static bool EstInconnu(unsigned char c) {
+    return !(EstAlpha(c) || EstChiffre(c) || strchr("\" \n\r\t()<>=!%&|}-;.", c)) || c == 0;
+}
+
+// Mots-clés : reconnus comme MOTCLE, les autres mots comme ID
+static bool EstMotCle(const char* p, size_t n) {
+    static const char* const mots[] = {
+        "IF", "THEN", "ELSE", "WHILE", "FOR", "DO", "TO", "BEGIN", "END", "VAR",
+        "BOOLEAN", "INTEGER", "CHAR", "DOUBLE", "DISPLAY", "CASE", "OF",
+        "PROCEDURE", "FUNCTION", 0
+    };
+    if (*p < 'B' || *p > 'W')       // première lettre des mots-clés
+        return false;
+    for (int i = 0; mots[i]; i++)
+        if (strlen(mots[i]) == n && memcmp(mots[i], p, n) == 0)
+            return true;
+    return false;
+}
+
+
+// === SimdLexer ===
+
+SimdLexer::SimdLexer(istream* entree)
+    : entree(entree ? entree : &cin), charge(false), taille(0), position(0), lignes(1),
+      suivant(0), ligne(1) {
+}
+
+// Lit tout le source ; les zéros de la marge permettent de lire 32 octets
+// au-delà de la fin sans test de longueur
+void SimdLexer::Charge() {
+    tampon.assign(istreambuf_iterator<char>(*entree), istreambuf_iterator<char>());
+    taille = tampon.size();
+    tampon.append(MARGE, '\0');
+    charge = true;
+}
+
+// Analyse le lot de lexèmes suivant (au plus TAILLE_LOT, FEOF termine le dernier)
+void SimdLexer::Remplit() {
+    bool avx2 = AvecAvx2();
+    const char* s = tampon.data();
+    lot.clear();
+    suivant = 0;
+
+    while (lot.size() < TAILLE_LOT) {
+        // {ws} et "(*" ... "*)"
+        for (;;) {
+            position += avx2 ? BlancsAvx2(s + position, &lignes) : BlancsSse2(s + position, &lignes);
+            if (position + 1 < taille && s[position] == '(' && s[position + 1] == '*') {
+                position += 2;
+                size_t reste = taille - position;
+                position += avx2 ? CommentaireAvx2(s + position, reste, &lignes)
+                                 : CommentaireSse2(s + position, reste, &lignes);
+                continue;
+            }
+            break;
+        }
+        if (position >= taille) {
+            position = taille;
+            lot.push_back({FEOF, (unsigned)taille, 0, lignes});
+            return;
+        }
+
+        const char* p = s + position;
+        unsigned char c = *p;
+        TOKEN t = UNKNOWN;
+        size_t n = 0;               // longueur reconnue par les règles autres que {unknown}
+        int sauts = 0;              // '\n' à l'intérieur du lexème
+
+        if (EstAlpha(c)) {
+            n = avx2 ? AlnumAvx2(p) : AlnumSse2(p);
+            t = EstMotCle(p, n) ? MOTCLE : ID;
+        }
+        else if (EstChiffre(c)) {
+            n = avx2 ? ChiffresAvx2(p) : ChiffresSse2(p);
+            if (p[n] == '.' && EstChiffre(p[n + 1])) {
+                n += 1 + (avx2 ? ChiffresAvx2(p + n + 1) : ChiffresSse2(p + n + 1));
+                t = DOUBLE_CONST_TOKEN;
+            }
+            else
+                t = NUMBER;
+        }
+        else {
+            switch (c) {
+                case '+': case '-': t = ADDOP; n = 1; break;
+                case '*': case '/': case '%': t = MULOP; n = 1; break;
+                case '|': if (p[1] == '|') { t = ADDOP; n = 2; } break;
+                case '&': if (p[1] == '&') { t = MULOP; n = 2; } break;
+                case '<': case '>': t = RELOP; n = (p[1] == '=') ? 2 : 1; break;
+                case '=': if (p[1] == '=') { t = RELOP; n = 2; } break;
+                case '!': if (p[1] == '=') { t = RELOP; n = 2; } else { t = NOT; n = 1; } break;
+                case '[': t = RBRACKET; n = 1; break;
+                case ']': t = LBRACKET; n = 1; break;
+                case ',': t = COMMA; n = 1; break;
+                case ';': t = SEMICOLON; n = 1; break;
+                case '.': if (p[1] == '.') { t = DOTDOT; n = 2; } else { t = DOT; n = 1; } break;
+                case ':': if (p[1] == '=') { t = ASSIGN; n = 2; } else { t = COLON; n = 1; } break;
+                case '(': t = LPARENT; n = 1; break;
+                case ')': t = RPARENT; n = 1; break;
+                case '"': {
+                    size_t k = 1;
+                    while (position + k < taille && p[k] != '"' && p[k] != '\n')
+                        k++;
+                    if (k > 1 && position + k < taille && p[k] == '"') { t = STRINGCONST; n = k + 1; }
+                    break;
+                }
+                case '\'':
+                    if (position + 2 < taille && p[1] != '\'' && p[2] == '\'') {
+                        t = CHARCONST_TOKEN;
+                        n = 3;
+                        sauts = (p[1] == '\n');
+                    }
+                    break;
+            }
+        }
+
+        // {unknown} ne gagne que s'il est strictement plus long
+        if (EstInconnu(c)) {
+            size_t k = 0;
+            while (position + k < taille && EstInconnu(p[k]))
+                k++;
+            if (k > n) {
+                t = UNKNOWN;
+                n = k;
+                sauts = 0;
+            }
+        }
+
+        if (n == 0) {           // aucune règle : Flex ferait ECHO
+            position++;
+            continue;
+        }
+
+        lignes += sauts;
+        lot.push_back({t, (unsigned)position, (unsigned)n, lignes});
+        position += n;
+    }
+}
+
+int SimdLexer::yylex() {
+    if (!charge)
+        Charge();
+    if (suivant == lot.size())
+        Remplit();
+
+    const Lexeme& l = lot[suivant];
+    if (l.type != FEOF)
+        suivant++;              // FEOF reste en place : les appels suivants le redonnent
+    texte.assign(tampon, l.debut, l.longueur);
+    ligne = l.ligne;
+    return l.type;
+}
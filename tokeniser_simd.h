@@ -0,0 +1,55 @@
+// tokeniser_simd.h
+
+#ifndef TOKENISER_SIMD_H
+#define TOKENISER_SIMD_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "tokeniser.h"
+
+// Analyseur lexical écrit à la main, avec la même interface que le lexer Flex++
+// (tokeniser.l, qui reste la référence) :
+//   lexer->yylex()   retourne le TOKEN suivant
+//   lexer->YYText()  retourne le texte du lexème
+//   lexer->lineno()  retourne la ligne du lexème
+// Tout le source est lu d'un coup ; les blancs, les commentaires (* ... *),
+// les identificateurs et les nombres sont parcourus 16 (SSE2) ou 32 (AVX2)
+// octets à la fois. Les lexèmes sont produits par lots dans un tableau que
+// yylex() consomme.
+class SimdLexer {
+public:
+    SimdLexer(std::istream* entree = 0);    // 0 : lecture sur std::cin
+
+    int yylex();
+    const char* YYText() const { return texte.c_str(); }
+    int lineno() const { return ligne; }
+
+    // Jeu d'instructions choisi à l'exécution : "avx2" ou "sse2"
+    static const char* JeuInstructions();
+
+private:
+    struct Lexeme {
+        TOKEN type;
+        unsigned debut, longueur;   // position dans le tampon
+        int ligne;
+    };
+
+    std::istream* entree;
+    bool charge;
+    std::string tampon;             // source complet suivi de zéros (lectures vectorielles)
+    size_t taille;                  // taille du source, sans les zéros
+    size_t position;                // prochain octet à analyser
+    int lignes;                     // numéro de ligne à la position courante
+
+    std::vector<Lexeme> lot;        // lot de lexèmes en cours de consommation
+    size_t suivant;                 // prochain lexème du lot
+
+    std::string texte;              // texte du lexème courant
+    int ligne;                      // ligne du lexème courant
+
+    void Charge();
+    void Remplit();
+};
+
+#endif